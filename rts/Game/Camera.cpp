@@ -20,6 +20,10 @@ CONFIG(bool, EdgeMoveDynamic)
 	.defaultValue(true)
 	.description("If EdgeMove scrolling speed should fade with edge distance.");
 
+// queried every frame while edge-scrolling
+CONFIG_VALUE(float, EdgeMoveWidth);
+CONFIG_VALUE(bool, EdgeMoveDynamic);
+
 
 
 // cameras[ACTIVE] is just used to store which of the others is active
@@ -665,8 +669,8 @@ float3 CCamera::GetMoveVectorFromState(bool fromKeyState) const
 			(globalRendering->viewSizeX << 1):
 			(globalRendering->viewSizeX     );
 
-		const float width  = configHandler->GetFloat("EdgeMoveWidth");
-		const bool dynamic = configHandler->GetBool("EdgeMoveDynamic");
+		const float width  = cfgValueEdgeMoveWidth.Get();
+		const bool dynamic = cfgValueEdgeMoveDynamic.Get();
 
 		int2 border;
 		border.x = std::max<int>(1, screenW * width);
@@ -23,6 +23,10 @@ CONFIG(bool,  CamSpringZoomInToMousePos).defaultValue(true);
 CONFIG(bool,  CamSpringZoomOutFromMousePos).defaultValue(false);
 CONFIG(bool,  CamSpringEdgeRotate).defaultValue(false).description("Rotate camera when cursor touches screen borders.");
 
+// queried every frame (GetAzimuth via Update) and on every edge-move
+CONFIG_VALUE(bool, CamSpringLockCardinalDirections);
+CONFIG_VALUE(bool, CamSpringEdgeRotate);
+
 
 CSpringController::CSpringController()
 : rot(2.677f, 0.0f, 0.0f)
@@ -69,7 +73,7 @@ void CSpringController::MouseMove(float3 move)
 
 void CSpringController::ScreenEdgeMove(float3 move)
 {
-	const bool doRotate = configHandler->GetBool("CamSpringEdgeRotate");
+	const bool doRotate = cfgValueCamSpringEdgeRotate.Get();
 	const bool belowMax = (mouse->lasty < globalRendering->viewSizeY /  3);
 	const bool aboveMin = (mouse->lasty > globalRendering->viewSizeY / 10);
 
@@ -233,7 +237,7 @@ float CSpringController::MoveAzimuth(float move)
 
 	rot.y -= move;
 
-	if (configHandler->GetBool("CamSpringLockCardinalDirections"))
+	if (cfgValueCamSpringLockCardinalDirections.Get())
 		return GetRotationWithCardinalLock(rot.y);
 	if (KeyInput::GetKeyModState(KMOD_CTRL))
 		rot.y = Clamp(rot.y, minRot + 0.02f, maxRot - 0.02f);
@@ -244,7 +248,7 @@ float CSpringController::MoveAzimuth(float move)
 
 float CSpringController::GetAzimuth() const
 {
-	if (configHandler->GetBool("CamSpringLockCardinalDirections"))
+	if (cfgValueCamSpringLockCardinalDirections.Get())
 		return GetRotationWithCardinalLock(rot.y);
 	return rot.y;
 }
@@ -16,6 +16,7 @@
 #include "Sim/Misc/CollisionHandler.h"
 #include "Sim/Misc/CollisionVolume.h"
 #include "Sim/Misc/DamageArray.h"
+#include "Sim/Misc/ExplosionFalloff.h"
 #include "Sim/Misc/GeometricObjects.h"
 #include "Sim/Misc/GroundBlockingObjectMap.h"
 #include "Sim/Misc/QuadField.h"
@@ -96,6 +97,33 @@ float CGameHelper::CalcImpulseScale(const DamageArray& damages, const float expD
 	return Clamp(rawImpulseScale, -MAX_EXPLOSION_IMPULSE, MAX_EXPLOSION_IMPULSE);
 }
 
+float CGameHelper::GetExplosionDistance(const CUnit* unit, const float3& expPos, const float expRadius, float3& volPos)
+{
+	const LocalModelPiece* lhp = unit->GetLastHitPiece(gs->frameNum);
+	const CollisionVolume* vol = unit->GetCollisionVolume(lhp);
+
+	const float3& lhpPos = (lhp != nullptr && vol == lhp->GetCollisionVolume())? lhp->GetAbsolutePos(): ZeroVector;
+
+	volPos = vol->GetWorldSpacePos(unit, lhpPos);
+
+	// linear damage falloff with distance; none for impact-only explosions
+	return ((expRadius != 0.0f)? vol->GetPointSurfaceDistance(unit, lhp, expPos): 0.0f);
+}
+
+float CGameHelper::GetExplosionDistance(const CFeature* feature, const float3& expPos, const float expRadius, float3& volPos)
+{
+	const LocalModelPiece* lhp = feature->GetLastHitPiece(gs->frameNum);
+	const CollisionVolume* vol = feature->GetCollisionVolume(lhp);
+
+	const float3& lhpPos = (lhp != nullptr && vol == lhp->GetCollisionVolume())? lhp->GetAbsolutePos(): ZeroVector;
+
+	volPos = vol->GetWorldSpacePos(feature, lhpPos);
+
+	// linear damage falloff with distance; none for impact-only explosions
+	return ((expRadius != 0.0f)? vol->GetPointSurfaceDistance(feature, nullptr, expPos): 0.0f);
+}
+
+
 void CGameHelper::DoExplosionDamage(
 	CUnit* unit,
 	CUnit* owner,
@@ -113,26 +141,54 @@ void CGameHelper::DoExplosionDamage(
 	if (ignoreOwner && (unit == owner))
 		return;
 
-	const LocalModelPiece* lhp = unit->GetLastHitPiece(gs->frameNum);
-	const CollisionVolume* vol = unit->GetCollisionVolume(lhp);
-
-	const float3& lhpPos = (lhp != nullptr && vol == lhp->GetCollisionVolume())? lhp->GetAbsolutePos(): ZeroVector;
-	const float3& volPos = vol->GetWorldSpacePos(unit, lhpPos);
+	float3 volPos;
 
-	// linear damage falloff with distance
-	const float expDist = (expRadius != 0.0f) ? vol->GetPointSurfaceDistance(unit, lhp, expPos) : 0.0f;
-	const float expRim = expDist * expEdgeEffect;
+	const float expDist = GetExplosionDistance(unit, expPos, expRadius, volPos);
 
 	// return early if (distance > radius)
 	if (expDist > expRadius)
 		return;
 
-	// expEdgeEffect should be in [0, 1], so expRadius >= expDist >= expDist*expEdgeEffect
-	assert(expRadius >= expRim);
+	ApplyExplosionDamage(unit, owner, expPos, volPos, expDist, ExplosionFalloff::CalcDistanceMod(expRadius, expDist, expEdgeEffect), expSpeed, damages, weaponDefID, projectileID);
+}
+
+void CGameHelper::DoExplosionDamage(
+	CFeature* feature,
+	CUnit* owner,
+	const float3& expPos,
+	const float expRadius,
+	const float expEdgeEffect,
+	const DamageArray& damages,
+	const int weaponDefID,
+	const int projectileID
+) {
+	assert(feature != nullptr);
+
+	float3 volPos;
+
+	const float expDist = GetExplosionDistance(feature, expPos, expRadius, volPos);
+
+	if (expDist > expRadius)
+		return;
+
+	ApplyExplosionDamage(feature, owner, expPos, volPos, expDist, ExplosionFalloff::CalcDistanceMod(expRadius, expDist, expEdgeEffect), damages, weaponDefID, projectileID);
+}
 
+
+bool CGameHelper::ApplyExplosionDamage(
+	CUnit* unit,
+	CUnit* owner,
+	const float3& expPos,
+	const float3& volPos,
+	const float expDist,
+	const float expDistanceMod,
+	const float expSpeed,
+	const DamageArray& damages,
+	const int weaponDefID,
+	const int projectileID
+) {
 	// expMod will also be in [0, 1], no negatives
 	// TODO: damage attenuation for underwater units from surface explosions?
-	const float expDistanceMod = (expRadius + 0.001f - expDist) / (expRadius + 0.001f - expRim);
 	const float modImpulseScale = CalcImpulseScale(damages, expDistanceMod);
 
 	// NOTE: if an explosion occurs right underneath a
@@ -150,39 +206,25 @@ void CGameHelper::DoExplosionDamage(
 	if (expDist < (expSpeed * DIRECT_EXPLOSION_DAMAGE_SPEED_SCALE)) {
 		// damage directly
 		unit->DoDamage(expDamages, expImpulse, owner, weaponDefID, projectileID);
-	} else {
-		// damage later
-		waitingDamages[(gs->frameNum + int(expDist / expSpeed) - 3) & (waitingDamages.size() - 1)].emplace_back(std::move(expDamages), expImpulse, ((owner != nullptr)? owner->id: -1), unit->id, weaponDefID, projectileID);
+		return true;
 	}
+
+	// damage later
+	waitingDamages[(gs->frameNum + int(expDist / expSpeed) - 3) & (waitingDamages.size() - 1)].emplace_back(std::move(expDamages), expImpulse, ((owner != nullptr)? owner->id: -1), unit->id, weaponDefID, projectileID);
+	return false;
 }
 
-void CGameHelper::DoExplosionDamage(
+void CGameHelper::ApplyExplosionDamage(
 	CFeature* feature,
 	CUnit* owner,
 	const float3& expPos,
-	const float expRadius,
-	const float expEdgeEffect,
+	const float3& volPos,
+	const float expDist,
+	const float expDistanceMod,
 	const DamageArray& damages,
 	const int weaponDefID,
 	const int projectileID
 ) {
-	assert(feature != nullptr);
-
-	const LocalModelPiece* lhp = feature->GetLastHitPiece(gs->frameNum);
-	const CollisionVolume* vol = feature->GetCollisionVolume(lhp);
-
-	const float3& lhpPos = (lhp != nullptr && vol == lhp->GetCollisionVolume())? lhp->GetAbsolutePos(): ZeroVector;
-	const float3& volPos = vol->GetWorldSpacePos(feature, lhpPos);
-
-	const float expDist = (expRadius != 0.0f) ? vol->GetPointSurfaceDistance(feature, nullptr, expPos) : 0.0f;
-	const float expRim = expDist * expEdgeEffect;
-
-	if (expDist > expRadius)
-		return;
-
-	assert(expRadius >= expRim);
-
-	const float expDistanceMod = (expRadius + 0.001f - expDist) / (expRadius + 0.001f - expRim);
 	const float modImpulseScale = CalcImpulseScale(damages, expDistanceMod);
 
 	const float3 impulseDir = (volPos - expPos).SafeNormalize();
@@ -201,6 +243,12 @@ void CGameHelper::DamageObjectsInExplosionRadius(
 	static std::vector<CUnit*> unitCache;
 	static std::vector<CFeature*> featureCache;
 
+	// per-object distances, falloff modifiers and volume positions;
+	// indexed like the caches and subject to the same end-markers
+	static std::vector<float> expDists;
+	static std::vector<float> expMods;
+	static std::vector<float3> volPositions;
+
 	const unsigned int oldNumUnits = unitCache.size();
 	const unsigned int oldNumFeatures = featureCache.size();
 
@@ -209,20 +257,96 @@ void CGameHelper::DamageObjectsInExplosionRadius(
 	const unsigned int newNumUnits = unitCache.size();
 	const unsigned int newNumFeatures = featureCache.size();
 
-	// damage all units within the explosion radius
+	// evaluate all units first, then damage those within the explosion radius
 	// NOTE:
 	//   this can recursively trigger ::Explosion() again
 	//   which would overwrite our object cache if we did
 	//   not keep track of end-markers --> certain objects
 	//   would not be damaged AT ALL (!)
-	for (unsigned int n = oldNumUnits; n < newNumUnits; n++)
-		DoExplosionDamage(unitCache[n], params.owner, params.pos, expRad, params.explosionSpeed, params.edgeEffectiveness, params.ignoreOwner, params.damages, weaponDefID, params.projectileID);
+	//
+	//   direct damage runs synced code (Lua and script callins,
+	//   deaths, nested explosions) which can move, reshape or
+	//   kill objects later in the cache, so the batched values
+	//   are only trusted until the first direct hit; remaining
+	//   objects are re-evaluated one at a time as they were
+	//   before batching
+	{
+		const unsigned int oldNumDists = expDists.size();
+		const unsigned int newNumDists = oldNumDists + (newNumUnits - oldNumUnits);
+
+		expDists.resize(newNumDists);
+		expMods.resize(newNumDists);
+		volPositions.resize(newNumDists);
+
+		for (unsigned int n = oldNumUnits, k = oldNumDists; n < newNumUnits; n++, k++) {
+			expDists[k] = GetExplosionDistance(unitCache[n], params.pos, expRad, volPositions[k]);
+		}
+
+		ExplosionFalloff::CalcDistanceMods(expDists.data() + oldNumDists, expMods.data() + oldNumDists, newNumDists - oldNumDists, expRad, params.edgeEffectiveness);
+
+		bool batchValid = true;
+
+		for (unsigned int n = oldNumUnits, k = oldNumDists; n < newNumUnits; n++, k++) {
+			CUnit* unit = unitCache[n];
+
+			if (!batchValid) {
+				DoExplosionDamage(unit, params.owner, params.pos, expRad, params.explosionSpeed, params.edgeEffectiveness, params.ignoreOwner, params.damages, weaponDefID, params.projectileID);
+				continue;
+			}
+
+			if (params.ignoreOwner && (unit == params.owner))
+				continue;
+			if (expDists[k] > expRad)
+				continue;
+
+			batchValid = !ApplyExplosionDamage(unit, params.owner, params.pos, volPositions[k], expDists[k], expMods[k], params.explosionSpeed, params.damages, weaponDefID, params.projectileID);
+		}
+
+		expDists.resize(oldNumDists);
+		expMods.resize(oldNumDists);
+		volPositions.resize(oldNumDists);
+	}
 
 	unitCache.resize(oldNumUnits);
 
-	// damage all features within the explosion radius
-	for (unsigned int n = oldNumFeatures; n < newNumFeatures; n++)
-		DoExplosionDamage(featureCache[n], params.owner, params.pos, expRad, params.edgeEffectiveness, params.damages, weaponDefID, params.projectileID);
+	// damage all features within the explosion radius; these are
+	// evaluated after the units were damaged and, since features
+	// are always damaged directly, only until the first one is hit
+	{
+		const unsigned int oldNumDists = expDists.size();
+		const unsigned int newNumDists = oldNumDists + (newNumFeatures - oldNumFeatures);
+
+		expDists.resize(newNumDists);
+		expMods.resize(newNumDists);
+		volPositions.resize(newNumDists);
+
+		for (unsigned int n = oldNumFeatures, k = oldNumDists; n < newNumFeatures; n++, k++) {
+			expDists[k] = GetExplosionDistance(featureCache[n], params.pos, expRad, volPositions[k]);
+		}
+
+		ExplosionFalloff::CalcDistanceMods(expDists.data() + oldNumDists, expMods.data() + oldNumDists, newNumDists - oldNumDists, expRad, params.edgeEffectiveness);
+
+		bool batchValid = true;
+
+		for (unsigned int n = oldNumFeatures, k = oldNumDists; n < newNumFeatures; n++, k++) {
+			CFeature* feature = featureCache[n];
+
+			if (!batchValid) {
+				DoExplosionDamage(feature, params.owner, params.pos, expRad, params.edgeEffectiveness, params.damages, weaponDefID, params.projectileID);
+				continue;
+			}
+
+			if (expDists[k] > expRad)
+				continue;
+
+			ApplyExplosionDamage(feature, params.owner, params.pos, volPositions[k], expDists[k], expMods[k], params.damages, weaponDefID, params.projectileID);
+			batchValid = false;
+		}
+
+		expDists.resize(oldNumDists);
+		expMods.resize(oldNumDists);
+		volPositions.resize(oldNumDists);
+	}
 
 	featureCache.resize(oldNumFeatures);
 }
@@ -154,6 +154,36 @@ public:
 	void DamageObjectsInExplosionRadius(const CExplosionParams& params, const float expRad, const int weaponDefID);
 	void Explosion(const CExplosionParams& params);
 
+private:
+	/// distance from expPos to the surface of the object's (last-hit) volume (zero if expRadius is), whose center is returned in volPos
+	static float GetExplosionDistance(const CUnit* unit, const float3& expPos, const float expRadius, float3& volPos);
+	static float GetExplosionDistance(const CFeature* feature, const float3& expPos, const float expRadius, float3& volPos);
+
+	/// returns true if the damage was applied immediately rather than queued
+	bool ApplyExplosionDamage(
+		CUnit* unit,
+		CUnit* owner,
+		const float3& expPos,
+		const float3& volPos,
+		const float expDist,
+		const float expDistanceMod,
+		const float expSpeed,
+		const DamageArray& damages,
+		const int weaponDefID,
+		const int projectileID
+	);
+	void ApplyExplosionDamage(
+		CFeature* feature,
+		CUnit* owner,
+		const float3& expPos,
+		const float3& volPos,
+		const float expDist,
+		const float expDistanceMod,
+		const DamageArray& damages,
+		const int weaponDefID,
+		const int projectileID
+	);
+
 private:
 	struct WaitingDamage {
 		WaitingDamage(const DamageArray& _damage, const float3& _impulse, int _attackerID, int _targetID, int _weaponID, int _projectileID)
@@ -18,6 +18,8 @@
 #include "Sim/Units/UnitDef.h"
 #include "Net/Protocol/NetProtocol.h"
 
+#include <algorithm>
+
 const int CMDPARAM_MOVE_X = 0;
 const int CMDPARAM_MOVE_Y = 1;
 const int CMDPARAM_MOVE_Z = 2;
@@ -349,67 +351,83 @@ void CSelectedUnitsHandlerAI::MakeFrontMove(Command* c,int player)
 	if(numColumns==0)
 		numColumns=1;
 
-	std::multimap<float,int> orderedUnits;
-	CreateUnitOrder(orderedUnits,player);
+	CreateUnitOrder(orderedUnits, player);
+
+	// orderedUnits is sorted by value, so equal-valued units of a row form
+	// contiguous runs; rowGroups holds the [begin, end) index of each run
+	std::vector<std::pair<int, Command> > frontcmds;
+	size_t rowBeg = 0;
+
+	frontcmds.reserve(orderedUnits.size());
 
-	std::multimap<float, std::vector<int> > sortUnits;
-	std::vector<std::pair<int,Command> > frontcmds;
-	for (std::multimap<float,int>::iterator oi = orderedUnits.begin(); oi != orderedUnits.end();){
+	for (size_t oi = 0; oi < orderedUnits.size(); ) {
 		bool newline;
-		nextPos = MoveToPos(oi->second, nextPos, sd, c, &frontcmds, &newline);
-		// mix units in each row to avoid weak flanks consisting solely of e.g. artillery units
-		std::multimap<float, std::vector<int> >::iterator si = sortUnits.find(oi->first);
-		if(si == sortUnits.end())
-			si = sortUnits.insert(std::pair<float, std::vector<int> >(oi->first, std::vector<int>()));
-		si->second.push_back(oi->second);
+		nextPos = MoveToPos(orderedUnits[oi].second, nextPos, sd, c, &frontcmds, &newline);
 		++oi;
 
-		if(oi != orderedUnits.end())
-			MoveToPos(oi->second, nextPos, sd, c, NULL, &newline);
+		if (oi != orderedUnits.size())
+			MoveToPos(orderedUnits[oi].second, nextPos, sd, c, NULL, &newline);
 
-		if(oi == orderedUnits.end() || newline) {
-			std::vector<std::vector<int>*> sortUnitsVector;
-			for (std::multimap<float, std::vector<int> >::iterator ui = sortUnits.begin(); ui!=sortUnits.end(); ++ui) {
-				sortUnitsVector.push_back(&(*ui).second);
-			}
+		if (oi != orderedUnits.size() && !newline)
+			continue;
 
-			std::vector<int> randunits;
-			int sz = sortUnitsVector.size();
-			std::vector<int> sortPos(sz, 0);
-			for (std::vector<std::pair<int,Command> >::iterator fi = frontcmds.begin(); fi != frontcmds.end(); ++fi) {
-				int bestpos = 0;
-				float bestval = 1.0f;
-				for (int i = 0; i < sz; ++i) {
-					const int n = sortUnitsVector[i]->size();
-					const int k = sortPos[i];
-					if (k < n) {
-						const float val = (0.5f + k) / (float)n;
-						if (val < bestval) {
-							bestval = val;
-							bestpos = i;
-						}
-					}
-				}
-				int pos = sortPos[bestpos];
-				randunits.push_back((*sortUnitsVector[bestpos])[pos]);
-				sortPos[bestpos] = pos + 1;
+		// mix units in each row to avoid weak flanks consisting solely of e.g. artillery units
+		rowGroups.clear();
+
+		for (size_t ri = rowBeg; ri < oi; ri++) {
+			if (ri == rowBeg || orderedUnits[ri].first != orderedUnits[ri - 1].first) {
+				rowGroups.emplace_back(ri, ri);
 			}
-			sortUnits.clear();
+			rowGroups.back().second = ri + 1;
+		}
+
+		// k-way merge that repeatedly takes the next unit from the group
+		// which has handed out the smallest fraction of its members; ties
+		// go to the group with the lowest value (ie. lowest index)
+		const auto groupCmp = [](const std::pair<float, int>& a, const std::pair<float, int>& b) {
+			return ((a.first > b.first) || (a.first == b.first && a.second > b.second));
+		};
 
-			int i = 0;
-			for (auto fi = frontcmds.begin(); fi != frontcmds.end(); ++fi) {
-				unitHandler->GetUnit(randunits[i++])->commandAI->GiveCommand(fi->second, false);
+		rowGroupQueue.clear();
+		rowGroupPos.clear();
+		rowGroupPos.resize(rowGroups.size(), 0);
+
+		for (size_t gi = 0; gi < rowGroups.size(); gi++) {
+			rowGroupQueue.emplace_back(0.5f / (float)(rowGroups[gi].second - rowGroups[gi].first), gi);
+		}
+
+		std::make_heap(rowGroupQueue.begin(), rowGroupQueue.end(), groupCmp);
+
+		for (auto fi = frontcmds.begin(); fi != frontcmds.end(); ++fi) {
+			std::pop_heap(rowGroupQueue.begin(), rowGroupQueue.end(), groupCmp);
+
+			const int gi = rowGroupQueue.back().second;
+			const int n = rowGroups[gi].second - rowGroups[gi].first;
+			const int k = rowGroupPos[gi]++;
+
+			unitHandler->GetUnit(orderedUnits[rowGroups[gi].first + k].second)->commandAI->GiveCommand(fi->second, false);
+
+			if ((k + 1) < n) {
+				rowGroupQueue.back().first = (0.5f + (k + 1)) / (float)n;
+				std::push_heap(rowGroupQueue.begin(), rowGroupQueue.end(), groupCmp);
+			} else {
+				rowGroupQueue.pop_back();
 			}
-			frontcmds.clear();
 		}
+
+		frontcmds.clear();
+		rowBeg = oi;
 	}
 }
 
 
-void CSelectedUnitsHandlerAI::CreateUnitOrder(std::multimap<float,int>& out,int player)
+void CSelectedUnitsHandlerAI::CreateUnitOrder(std::vector< std::pair<float, int> >& out, int player)
 {
 	const std::vector<int>& netUnits = selectedUnitsHandler.netSelected[player];
 
+	out.clear();
+	out.reserve(netUnits.size());
+
 	for (auto ui = netUnits.cbegin(); ui != netUnits.cend(); ++ui) {
 		const CUnit* unit = unitHandler->GetUnit(*ui);
 
@@ -421,9 +439,12 @@ void CSelectedUnitsHandlerAI::CreateUnitOrder(std::multimap<float,int>& out,int
 				range = 2000;
 			}
 			const float value = ((ud->metal * 60) + ud->energy) / unit->unitDef->health * range;
-			out.insert(std::pair<float, int>(value, *ui));
+			out.emplace_back(value, *ui);
 		}
 	}
+
+	// stable, so equal values keep selection order (as a multimap would)
+	std::stable_sort(out.begin(), out.end(), [](const std::pair<float, int>& a, const std::pair<float, int>& b) { return (a.first < b.first); });
 }
 
 
@@ -5,8 +5,7 @@
 
 #include "Sim/Units/CommandAI/Command.h"
 #include "System/float3.h"
-#include <map>
-#include <set>
+#include <vector>
 
 class CUnit;
 
@@ -33,7 +32,7 @@ public:
 private:
 	void CalculateGroupData(int player, bool queueing);
 	void MakeFrontMove(Command* c, int player);
-	void CreateUnitOrder(std::multimap<float, int>& out, int player);
+	void CreateUnitOrder(std::vector< std::pair<float, int> >& out, int player);
 	float3 MoveToPos(int unit, float3 nextCornerPos, float3 dir, Command* command, std::vector<std::pair<int, Command> >* frontcmds, bool* newline);
 	void AddUnitSetMaxSpeedCommand(CUnit* unit, unsigned char options);
 	void AddGroupSetMaxSpeedCommand(CUnit* unit, unsigned char options);
@@ -49,6 +48,12 @@ private:
 	float3 sideDir;
 	float columnDist;
 	int numColumns;
+
+	// MakeFrontMove scratch-space, kept to avoid reallocating per order
+	std::vector< std::pair<float, int> > orderedUnits; // <value, unitID>
+	std::vector< std::pair<size_t, size_t> > rowGroups;
+	std::vector< std::pair<float, int> > rowGroupQueue; // <fraction handed out, group>
+	std::vector<int> rowGroupPos;
 };
 
 extern CSelectedUnitsHandlerAI selectedUnitsAI;
@@ -54,6 +54,8 @@ CSelectedUnitsHandler selectedUnitsHandler;
 CSelectedUnitsHandler::CSelectedUnitsHandler()
 	: selectionChanged(false)
 	, possibleCommandsChanged(true)
+	, selectionChangeCount(0)
+	, availableCommandsSelCount(-1u)
 	, selectedGroup(-1)
 	, soundMultiselID(0)
 	, autoAddBuiltUnitsToFactoryGroup(false)
@@ -93,86 +95,182 @@ void CSelectedUnitsHandler::ToggleBuildIconsFirst()
 }
 
 
-CSelectedUnitsHandler::AvailableCommandsStruct CSelectedUnitsHandler::GetAvailableCommands()
+void CSelectedUnitsHandler::AddUnitCommands(const CUnit* unit)
 {
-	possibleCommandsChanged = false;
-
-	int commandPage = 1000;
-	int foundGroup = -2;
-	int foundGroup2 = -2;
+	std::vector<int>& unitCmdIDs = selectedUnitCommands[unit->id];
 
-	std::map<int, int> states;
-	std::vector<SCommandDescription> commands;
+	assert(unitCmdIDs.empty());
 
-	for (const int unitID: selectedUnits) {
-		const CUnit* u = unitHandler->GetUnit(unitID);
+	for (const SCommandDescription* cmdDesc: unit->commandAI->GetPossibleCommands()) {
+		const auto it = selectedCommands.find(cmdDesc->id);
 
-		for (const SCommandDescription* cmdDesc: u->commandAI->GetPossibleCommands()) {
-			states[cmdDesc->id] = cmdDesc->disabled ? 2 : 1;
+		if (it == selectedCommands.end()) {
+			selectedCommands[cmdDesc->id] = {1, unit->id, false};
+			selectedCommandOrder.push_back(cmdDesc->id);
+		} else {
+			it->second.refCount += 1;
 		}
 
-		if (u->commandAI->lastSelectedCommandPage < commandPage)
-			commandPage = u->commandAI->lastSelectedCommandPage;
+		unitCmdIDs.push_back(cmdDesc->id);
+	}
+}
+
+void CSelectedUnitsHandler::RemoveUnitCommands(int unitID)
+{
+	const auto uit = selectedUnitCommands.find(unitID);
 
-		if (foundGroup == -2 && u->group)
-			foundGroup = u->group->id;
+	if (uit == selectedUnitCommands.end())
+		return;
 
-		if (!u->group || foundGroup != u->group->id)
-			foundGroup = -1;
+	for (const int cmdID: uit->second) {
+		const auto it = selectedCommands.find(cmdID);
 
-		if (foundGroup2 == -2 && u->group)
-			foundGroup2 = u->group->id;
+		assert(it != selectedCommands.end());
 
-		if (foundGroup2 >= 0 && u->group && u->group->id != foundGroup2)
-			foundGroup2 = -1;
+		if ((it->second.refCount -= 1) == 0) {
+			selectedCommands.erase(it);
+			selectedCommandOrder.erase(std::find(selectedCommandOrder.begin(), selectedCommandOrder.end(), cmdID));
+			continue;
+		}
+
+		// another unit still offers it, find out which one on demand
+		if (it->second.ownerID == unitID)
+			it->second.ownerID = -1;
 	}
 
-	// load the first set (separating build and non-build commands)
+	selectedUnitCommands.erase(uit);
+}
+
+void CSelectedUnitsHandler::ResetUnitCommands()
+{
+	selectedCommands.clear();
+	selectedUnitCommands.clear();
+	selectedCommandOrder.clear();
+
 	for (const int unitID: selectedUnits) {
+		AddUnitCommands(unitHandler->GetUnit(unitID));
+	}
+}
+
+
+const SCommandDescription* CSelectedUnitsHandler::GetSelectedCommandDesc(int cmdID, SelectedCommand& sc) const
+{
+	const auto FindUnitCommandDesc = [cmdID](int unitID) -> const SCommandDescription* {
 		const CUnit* u = unitHandler->GetUnit(unitID);
 
 		for (const SCommandDescription* cmdDesc: u->commandAI->GetPossibleCommands()) {
-			if (buildIconsFirst) {
-				if (cmdDesc->id >= 0) { continue; }
-			} else {
-				if (cmdDesc->id < 0)  { continue; }
-			}
+			if (cmdDesc->id == cmdID)
+				return cmdDesc;
+		}
 
-			if (cmdDesc->showUnique && selectedUnits.size() > 1)
-				continue;
+		return nullptr;
+	};
 
-			if (states[cmdDesc->id] > 0) {
-				commands.push_back(*cmdDesc);
-				states[cmdDesc->id] = 0;
-			}
+	if (sc.ownerID != -1)
+		return (FindUnitCommandDesc(sc.ownerID));
+
+	// previous owner left the selection
+	for (const auto& p: selectedUnitCommands) {
+		if (std::find(p.second.begin(), p.second.end(), cmdID) == p.second.end())
+			continue;
+
+		sc.ownerID = p.first;
+		return (FindUnitCommandDesc(sc.ownerID));
+	}
+
+	return nullptr;
+}
+
+
+void CSelectedUnitsHandler::UpdateCommandOrder()
+{
+	if (selectedUnits.empty())
+		return;
+
+	// the refcounts only track membership; a unit's own list can have
+	// commands inserted anywhere or be reordered (e.g. by Lua), so take
+	// the order from one of the units and append whatever only the other
+	// units offer in order of first appearance
+	const CUnit* unit = unitHandler->GetUnit(*selectedUnits.begin());
+
+	std::vector<int> commandOrder;
+	commandOrder.reserve(selectedCommandOrder.size());
+
+	for (const SCommandDescription* cmdDesc: unit->commandAI->GetPossibleCommands()) {
+		const auto it = selectedCommands.find(cmdDesc->id);
+
+		if (it == selectedCommands.end() || it->second.listed)
+			continue;
+
+		it->second.listed = true;
+		commandOrder.push_back(cmdDesc->id);
+	}
+
+	for (const int cmdID: selectedCommandOrder) {
+		SelectedCommand& sc = selectedCommands[cmdID];
+
+		if (sc.listed) {
+			sc.listed = false;
+			continue;
 		}
+
+		commandOrder.push_back(cmdID);
 	}
 
-	// load the second set (all those that have not already been included)
+	selectedCommandOrder.swap(commandOrder);
+}
+
+void CSelectedUnitsHandler::BuildAvailableCommands(AvailableCommandsStruct& ac)
+{
+	UpdateCommandOrder();
+
+	ac.commands.clear();
+	ac.commands.reserve(selectedCommandOrder.size());
+	ac.commandPage = 1000;
+
 	for (const int unitID: selectedUnits) {
-		const CUnit* u = unitHandler->GetUnit(unitID);
+		ac.commandPage = std::min(ac.commandPage, unitHandler->GetUnit(unitID)->commandAI->lastSelectedCommandPage);
+	}
 
-		for (const SCommandDescription* cmdDesc: u->commandAI->GetPossibleCommands()) {
-			if (buildIconsFirst) {
-				if (cmdDesc->id < 0)  { continue; }
-			} else {
-				if (cmdDesc->id >= 0) { continue; }
-			}
+	// load the first set (separating build and non-build commands), then
+	// the second set; each command appears once, taken from one of the
+	// units offering it
+	for (int n = 0; n < 2; n++) {
+		const bool buildSet = (buildIconsFirst == (n == 0));
+
+		for (const int cmdID: selectedCommandOrder) {
+			if ((cmdID < 0) != buildSet)
+				continue;
+
+			const SCommandDescription* cmdDesc = GetSelectedCommandDesc(cmdID, selectedCommands[cmdID]);
 
+			if (cmdDesc == nullptr)
+				continue;
 			if (cmdDesc->showUnique && selectedUnits.size() > 1)
 				continue;
 
-			if (states[cmdDesc->id] > 0) {
-				commands.push_back(*cmdDesc);
-				states[cmdDesc->id] = 0;
-			}
+			ac.commands.push_back(*cmdDesc);
 		}
 	}
+}
 
-	AvailableCommandsStruct ac;
-	ac.commandPage = commandPage;
-	ac.commands = commands;
-	return ac;
+CSelectedUnitsHandler::AvailableCommandsStruct CSelectedUnitsHandler::GetAvailableCommands()
+{
+	if (possibleCommandsChanged) {
+		BuildAvailableCommands(availableCommands);
+
+		possibleCommandsChanged = false;
+		availableCommandsSelCount = selectionChangeCount;
+	} else {
+		// pages are flipped without notification, never cache them
+		availableCommands.commandPage = 1000;
+
+		for (const int unitID: selectedUnits) {
+			availableCommands.commandPage = std::min(availableCommands.commandPage, unitHandler->GetUnit(unitID)->commandAI->lastSelectedCommandPage);
+		}
+	}
+
+	return availableCommands;
 }
 
 
@@ -361,10 +459,13 @@ void CSelectedUnitsHandler::AddUnit(CUnit* unit)
 	if (unit->noSelect)
 		return;
 
-	if (selectedUnits.insert(unit->id).second)
+	if (selectedUnits.insert(unit->id).second) {
 		AddDeathDependence(unit, DEPENDENCE_SELECTED);
+		AddUnitCommands(unit);
+	}
 
 	selectionChanged = true;
+	selectionChangeCount++;
 	possibleCommandsChanged = true;
 
 	if (!(unit->group) || unit->group->id != selectedGroup)
@@ -376,10 +477,13 @@ void CSelectedUnitsHandler::AddUnit(CUnit* unit)
 
 void CSelectedUnitsHandler::RemoveUnit(CUnit* unit)
 {
-	if (selectedUnits.erase(unit->id))
+	if (selectedUnits.erase(unit->id)) {
 		DeleteDeathDependence(unit, DEPENDENCE_SELECTED);
+		RemoveUnitCommands(unit->id);
+	}
 
 	selectionChanged = true;
+	selectionChangeCount++;
 	possibleCommandsChanged = true;
 	selectedGroup = -1;
 	unit->isSelected = false;
@@ -402,7 +506,9 @@ void CSelectedUnitsHandler::ClearSelected()
 	}
 
 	selectedUnits.clear();
+	ResetUnitCommands();
 	selectionChanged = true;
+	selectionChangeCount++;
 	possibleCommandsChanged = true;
 	selectedGroup = -1;
 }
@@ -421,10 +527,12 @@ void CSelectedUnitsHandler::SelectGroup(int num)
 			u->isSelected = true;
 			selectedUnits.insert(u->id);
 			AddDeathDependence(u, DEPENDENCE_SELECTED);
+			AddUnitCommands(u);
 		}
 	}
 
 	selectionChanged = true;
+	selectionChangeCount++;
 	possibleCommandsChanged = true;
 }
 
@@ -643,8 +751,11 @@ void CSelectedUnitsHandler::Draw()
 
 void CSelectedUnitsHandler::DependentDied(CObject *o)
 {
-	selectedUnits.erase(static_cast<CUnit*>(o)->id);
+	if (selectedUnits.erase(static_cast<CUnit*>(o)->id))
+		RemoveUnitCommands(static_cast<CUnit*>(o)->id);
+
 	selectionChanged = true;
+	selectionChangeCount++;
 	possibleCommandsChanged = true;
 }
 
@@ -697,7 +808,27 @@ void CSelectedUnitsHandler::AiOrder(int unitid, const Command &c, int playerId)
 
 bool CSelectedUnitsHandler::CommandsChanged()
 {
-	return possibleCommandsChanged;
+	if (!possibleCommandsChanged)
+		return false;
+
+	// selection itself changed; LuaUI layouts may depend on the units
+	if (availableCommandsSelCount != selectionChangeCount)
+		return true;
+
+	// only descriptions changed (e.g. a state toggle or stockpile count);
+	// skip the GUI re-layout if the aggregate result is still the same
+	AvailableCommandsStruct ac;
+	BuildAvailableCommands(ac);
+
+	const bool changed =
+		(ac.commandPage != availableCommands.commandPage) ||
+		(ac.commands.size() != availableCommands.commands.size()) ||
+		!std::equal(ac.commands.begin(), ac.commands.end(), availableCommands.commands.begin(), [](const SCommandDescription& a, const SCommandDescription& b) { return !(a != b); });
+
+	if (!changed)
+		possibleCommandsChanged = false;
+
+	return changed;
 }
 
 
@@ -807,8 +938,18 @@ int CSelectedUnitsHandler::GetDefaultCmd(const CUnit* unit, const CFeature* feat
 
 void CSelectedUnitsHandler::PossibleCommandChange(CUnit* sender)
 {
-	if (sender == NULL || selectedUnits.find(sender->id) != selectedUnits.end())
+	if (sender == nullptr) {
+		ResetUnitCommands();
 		possibleCommandsChanged = true;
+		return;
+	}
+
+	if (selectedUnits.find(sender->id) == selectedUnits.end())
+		return;
+
+	RemoveUnitCommands(sender->id);
+	AddUnitCommands(sender);
+	possibleCommandsChanged = true;
 }
 
 // CALLINFO:
@@ -9,6 +9,7 @@
 #include "Sim/Units/CommandAI/Command.h"
 #include "System/float4.h"
 #include "System/Object.h"
+#include "System/UnorderedMap.hpp"
 #include "System/UnorderedSet.hpp"
 
 class CUnit;
@@ -69,10 +70,42 @@ public:
 	bool selectionChanged;
 	bool possibleCommandsChanged;
 
+	/// incremented on every change, unlike selectionChanged never reset
+	unsigned int selectionChangeCount;
+
 	spring::unordered_set<int> selectedUnits;
 	std::vector< std::vector<int> > netSelected;
 
 private:
+	struct SelectedCommand {
+		int refCount;
+		int ownerID; ///< id of a selected unit offering this command, -1 if unknown
+		bool listed; ///< scratch flag for UpdateCommandOrder
+	};
+
+	void AddUnitCommands(const CUnit* unit);
+	void RemoveUnitCommands(int unitID);
+	void ResetUnitCommands();
+	void UpdateCommandOrder();
+	void BuildAvailableCommands(AvailableCommandsStruct& ac);
+	const SCommandDescription* GetSelectedCommandDesc(int cmdID, SelectedCommand& sc) const;
+
+private:
+	// union of the command descriptions offered by the selected units,
+	// maintained as units join or leave the selection (or change their
+	// descriptions) instead of rescanning every unit per rebuild
+	spring::unsynced_map<int, SelectedCommand> selectedCommands;
+	spring::unsynced_map<int, std::vector<int> > selectedUnitCommands;
+
+	/// command ids in the order of one selected unit's list, followed by
+	/// those only other units offer; refreshed on every rebuild
+	std::vector<int> selectedCommandOrder;
+
+	/// result of the last rebuild, returned while nothing changed
+	AvailableCommandsStruct availableCommands;
+	/// value of selectionChangeCount when availableCommands was built
+	unsigned int availableCommandsSelCount;
+
 	int selectedGroup;
 	int soundMultiselID;
 
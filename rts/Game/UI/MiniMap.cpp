@@ -1478,6 +1478,8 @@ void CMiniMap::DrawBackground() const
 
 void CMiniMap::DrawUnitIcons() const
 {
+	SCOPED_TIMER("Draw::Screen::InputReceivers::MiniMap::UnitIcons");
+
 	// switch to top-down map/world coords (z is twisted with y compared to the real map/world coords)
 	glPushMatrix();
 	glTranslatef(0.0f, +1.0f, 0.0f);
@@ -389,7 +389,7 @@ static void DrawInfoText()
 	const char* pfsFmtStr = "[6] (%s)PFS-updates queued: {%i, %i}";
 	const char* luaFmtStr = "[7] Lua-allocated memory: %.1fMB (%.5uK allocs : %.5u usecs : %.1u states)";
 	const char* gpuFmtStr = "[8] GPU-allocated memory: %.1fMB / %.1fMB";
-	const char* sopFmtStr = "[9] SOP-allocated memory: {U,F,P,W}={%.1f/%.1f, %.1f/%.1f, %.1f/%.1f, %.1f/%.1f}KB";
+	const char* sopFmtStr = "[9] SOP-allocated memory (live/total): {U,F,P,W}={%.1f/%.1f, %.1f/%.1f, %.1f/%.1f, %.1f/%.1f}KB";
 
 	const CProjectileHandler* ph = projectileHandler;
 	const IPathManager* pm = pathManager;
@@ -440,14 +440,14 @@ static void DrawInfoText()
 	}
 
 	font->glFormat(0.01f, 0.18f, 0.5f, DBG_FONT_FLAGS, sopFmtStr,
+		unitMemPool.live_size() / 1024.0f,
 		unitMemPool.alloc_size() / 1024.0f,
-		unitMemPool.freed_size() / 1024.0f,
+		featureMemPool.live_size() / 1024.0f,
 		featureMemPool.alloc_size() / 1024.0f,
-		featureMemPool.freed_size() / 1024.0f,
+		projMemPool.live_size() / 1024.0f,
 		projMemPool.alloc_size() / 1024.0f,
-		projMemPool.freed_size() / 1024.0f,
-		weaponMemPool.alloc_size() / 1024.0f,
-		weaponMemPool.freed_size() / 1024.0f
+		weaponMemPool.live_size() / 1024.0f,
+		weaponMemPool.alloc_size() / 1024.0f
 	);
 }
 
@@ -54,12 +54,14 @@
 #include "Rendering/Map/InfoTexture/Modern/Path.h"
 #include "Lua/LuaOpenGL.h"
 #include "Lua/LuaUI.h"
+#include "Sim/Features/FeatureHandler.h"
 #include "Sim/MoveTypes/MoveDefHandler.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Units/UnitHandler.h"
 #include "Sim/Units/UnitDef.h"
 #include "Sim/Units/UnitDefHandler.h"
+#include "Sim/Weapons/Weapon.h"
 #include "Game/UI/Groups/GroupHandler.h"
 #include "Sim/Projectiles/ProjectileHandler.h"
 #include "UI/CommandColors.h"
@@ -2883,15 +2885,19 @@ class DebugInfoActionExecutor : public IUnsyncedActionExecutor {
 public:
 	DebugInfoActionExecutor() : IUnsyncedActionExecutor("DebugInfo",
 			"Print debug info to the chat/log-file about either:"
-			" sound, profiling") {}
+			" sound, profiling, features, weapons") {}
 
 	bool Execute(const UnsyncedAction& action) const {
 		if (action.GetArgs() == "sound") {
 			sound->PrintDebugInfo();
 		} else if (action.GetArgs() == "profiling") {
 			profiler.PrintProfilingInfo();
+		} else if (action.GetArgs() == "features") {
+			featureHandler->PrintDebugInfo();
+		} else if (action.GetArgs() == "weapons") {
+			CWeapon::PrintDebugInfo();
 		} else {
-			LOG_L(L_WARNING, "Give either of these as argument: sound, profiling");
+			LOG_L(L_WARNING, "Give either of these as argument: sound, profiling, features, weapons");
 		}
 		return true;
 	}
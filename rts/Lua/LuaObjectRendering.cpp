@@ -471,6 +471,7 @@ int LuaObjectRenderingImpl::Debug(lua_State* L)
 	if (lua_gettop(L) == 0) {
 		// no arguments, dump all bins
 		luaMatHandler.PrintAllBins("");
+		LuaObjectDrawer::PrintDrawPassStats();
 		return 0;
 	}
 
@@ -11,8 +11,10 @@
 #include "LuaUtils.h"
 
 #include "Game/Camera.h"
+#include "Rendering/Shaders/ShaderHandler.h"
 #include "System/Log/ILog.h"
 #include "System/StringUtil.h"
+#include "System/TimeProfiler.h"
 
 #include <string>
 #include <vector>
@@ -481,8 +483,35 @@ static void ApplyGeometryParameters(lua_State* L, int table, GLuint prog)
 }
 
 
+static std::string GetProgramSourceKey(
+	const std::vector<std::string>& defs,
+	const std::vector<std::string>& vertSrcs,
+	const std::vector<std::string>& fragSrcs
+) {
+	std::string key;
+
+	for (const std::string& def: defs)
+		key += def;
+
+	// separate the stages, moving code between them changes the program
+	key.append("\0vertex\0", 8);
+
+	for (const std::string& src: vertSrcs)
+		key += src;
+
+	key.append("\0fragment\0", 10);
+
+	for (const std::string& src: fragSrcs)
+		key += src;
+
+	return key;
+}
+
+
 int LuaShaders::CreateShader(lua_State* L)
 {
+	SCOPED_TIMER("Misc::LuaShaders::CreateShader");
+
 	const int args = lua_gettop(L);
 
 	if ((args != 1) || !lua_istable(L, 1))
@@ -507,51 +536,73 @@ int LuaShaders::CreateShader(lua_State* L)
 	if (vertSrcs.empty() && fragSrcs.empty() && geomSrcs.empty())
 		return 0;
 
-	bool success;
-	const GLuint vertObj = CompileObject(L, shdrDefs, vertSrcs, GL_VERTEX_SHADER, success);
+	CShaderHandler::ProgramBinaryCache& programBinaryCache = shaderHandler->GetProgramBinaryCache();
 
-	if (!success)
-		return 0;
+	// geometry-shader parameters are not part of the sources, never cache those
+	const bool cacheableProg = (geomSrcs.empty() && programBinaryCache.IsEnabled());
 
-	const GLuint geomObj = CompileObject(L, shdrDefs, geomSrcs, GL_GEOMETRY_SHADER_EXT, success);
+	CShaderHandler::ProgramBinaryCache::SourceHash srcHash = {};
 
-	if (!success) {
-		glDeleteShader(vertObj);
-		return 0;
-	}
-
-	const GLuint fragObj = CompileObject(L, shdrDefs, fragSrcs, GL_FRAGMENT_SHADER, success);
-
-	if (!success) {
-		glDeleteShader(vertObj);
-		glDeleteShader(geomObj);
-		return 0;
-	}
+	if (cacheableProg)
+		srcHash = CShaderHandler::ProgramBinaryCache::GetSourceHash(GetProgramSourceKey(shdrDefs, vertSrcs, fragSrcs));
 
 	const GLuint prog = glCreateProgram();
+	const bool cachedProg = (cacheableProg && programBinaryCache.Load(prog, srcHash));
 
 	Program p(prog);
 
-	if (vertObj != 0) {
-		glAttachShader(prog, vertObj);
-		p.objects.push_back(Object(vertObj, GL_VERTEX_SHADER));
-	}
-	if (geomObj != 0) {
-		glAttachShader(prog, geomObj);
-		p.objects.push_back(Object(geomObj, GL_GEOMETRY_SHADER_EXT));
-		ApplyGeometryParameters(L, 1, prog); // done before linking
-	}
-	if (fragObj != 0) {
-		glAttachShader(prog, fragObj);
-		p.objects.push_back(Object(fragObj, GL_FRAGMENT_SHADER));
+	if (!cachedProg) {
+		bool success;
+		const GLuint vertObj = CompileObject(L, shdrDefs, vertSrcs, GL_VERTEX_SHADER, success);
+
+		if (!success) {
+			glDeleteProgram(prog);
+			return 0;
+		}
+
+		const GLuint geomObj = CompileObject(L, shdrDefs, geomSrcs, GL_GEOMETRY_SHADER_EXT, success);
+
+		if (!success) {
+			glDeleteShader(vertObj);
+			glDeleteProgram(prog);
+			return 0;
+		}
+
+		const GLuint fragObj = CompileObject(L, shdrDefs, fragSrcs, GL_FRAGMENT_SHADER, success);
+
+		if (!success) {
+			glDeleteShader(vertObj);
+			glDeleteShader(geomObj);
+			glDeleteProgram(prog);
+			return 0;
+		}
+
+		if (vertObj != 0) {
+			glAttachShader(prog, vertObj);
+			p.objects.push_back(Object(vertObj, GL_VERTEX_SHADER));
+		}
+		if (geomObj != 0) {
+			glAttachShader(prog, geomObj);
+			p.objects.push_back(Object(geomObj, GL_GEOMETRY_SHADER_EXT));
+			ApplyGeometryParameters(L, 1, prog); // done before linking
+		}
+		if (fragObj != 0) {
+			glAttachShader(prog, fragObj);
+			p.objects.push_back(Object(fragObj, GL_FRAGMENT_SHADER));
+		}
+
+		glLinkProgram(prog);
 	}
 
 	GLint linkStatus;
 	GLint validStatus;
 
-	glLinkProgram(prog);
 	glGetProgramiv(prog, GL_LINK_STATUS, &linkStatus);
 
+	// store before any uniforms are set, binaries do not retain their values
+	if (!cachedProg && cacheableProg && linkStatus == GL_TRUE)
+		programBinaryCache.Save(prog, srcHash);
+
 	// Allows setting up uniforms when drawing is disabled
 	// (much more convenient for sampler uniforms, and static
 	//  configuration values)
@@ -1598,6 +1598,7 @@ int LuaUnsyncedCtrl::SetUnitNoMinimap(lua_State* L)
 		return 0;
 
 	unit->noMinimap = luaL_checkboolean(L, 2);
+	unitDrawer->MarkUnitMiniMapIcon(unit);
 	return 0;
 }
 
@@ -21,6 +21,7 @@ public:
 	);
 
 	void Update() override;
+	bool HasLocalUpdate() const override { return true; }
 	void Draw(CVertexArray* va) override;
 
 	int GetProjectilesCount() const override;
@@ -25,6 +25,7 @@ public:
 
 	void Draw(CVertexArray* va) override;
 	void Update() override;
+	bool HasLocalUpdate() const override { return true; }
 
 	int GetProjectilesCount() const override;
 
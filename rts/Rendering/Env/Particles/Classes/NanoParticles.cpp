@@ -0,0 +1,123 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+
+#include "NanoParticles.h"
+
+#include "Game/Camera.h"
+#include "Game/GlobalUnsynced.h"
+#include "Rendering/GlobalRendering.h"
+#include "Rendering/UnitDrawer.h"
+#include "Rendering/Env/Particles/ProjectileDrawer.h"
+#include "Rendering/GL/VertexArray.h"
+#include "Rendering/Textures/TextureAtlas.h"
+#include "Rendering/Colors.h"
+#include "Sim/Misc/LosHandler.h"
+
+// same as CNanoProjectile
+static constexpr float NANO_DRAW_RADIUS = 3.0f;
+
+
+void NanoParticles::Add(const float3 pos, const float3 speed, int deathFrame, const SColor color)
+{
+	positions.push_back(pos);
+	speeds.push_back(speed);
+	deathFrames.push_back(deathFrame);
+	colors.push_back(color);
+}
+
+void NanoParticles::Clear()
+{
+	positions.clear();
+	speeds.clear();
+	deathFrames.clear();
+	colors.clear();
+}
+
+
+size_t NanoParticles::Update(int frameNum)
+{
+	const size_t origSize = positions.size();
+	size_t size = origSize;
+
+	// a particle moves during the frame it dies in and is still drawn
+	// after it, which is when a CNanoProjectile would have been deleted
+	for (size_t i = 0; i < size; /*no-op*/) {
+		if (frameNum > deathFrames[i]) {
+			size -= 1;
+
+			positions[i] = positions[size];
+			speeds[i] = speeds[size];
+			deathFrames[i] = deathFrames[size];
+			colors[i] = colors[size];
+			continue;
+		}
+
+		positions[i] += speeds[i];
+		++i;
+	}
+
+	positions.resize(size);
+	speeds.resize(size);
+	deathFrames.resize(size);
+	colors.resize(size);
+
+	return (origSize - size);
+}
+
+
+bool NanoParticles::IsVisible(const float3 pos, const float3 speed, bool noLosTest) const
+{
+	if (noLosTest)
+		return true;
+
+	// same test as LosHandler does for projectiles
+	return (losHandler->InLos(pos, gu->myAllyTeam) || losHandler->InLos(pos + speed, gu->myAllyTeam));
+}
+
+void NanoParticles::Draw(CVertexArray* va, bool noLosTest, bool drawReflection, bool drawRefraction) const
+{
+	if (positions.empty())
+		return;
+
+	const CCamera* cam = CCamera::GetActiveCamera();
+	const AtlasedTexture* gfxt = projectileDrawer->gfxtex;
+
+	const float3 camRight = camera->GetRight() * NANO_DRAW_RADIUS;
+	const float3 camUp = camera->GetUp() * NANO_DRAW_RADIUS;
+
+	va->EnlargeArrays(positions.size() * 4, 0, VA_SIZE_TC);
+
+	for (size_t i = 0, n = positions.size(); i < n; ++i) {
+		const float3 drawPos = positions[i] + speeds[i] * globalRendering->timeOffset;
+
+		if (!IsVisible(positions[i], speeds[i], noLosTest))
+			continue;
+
+		if (drawRefraction && (drawPos.y > NANO_DRAW_RADIUS))
+			continue;
+		if (drawReflection && !CUnitDrawer::ObjectVisibleReflection(drawPos, camera->GetPos(), NANO_DRAW_RADIUS))
+			continue;
+		if (!cam->InView(drawPos, NANO_DRAW_RADIUS))
+			continue;
+
+		va->AddVertexQTC(drawPos - camRight - camUp, gfxt->xstart, gfxt->ystart, colors[i]);
+		va->AddVertexQTC(drawPos + camRight - camUp, gfxt->xend,   gfxt->ystart, colors[i]);
+		va->AddVertexQTC(drawPos + camRight + camUp, gfxt->xend,   gfxt->yend,   colors[i]);
+		va->AddVertexQTC(drawPos - camRight + camUp, gfxt->xstart, gfxt->yend,   colors[i]);
+	}
+}
+
+void NanoParticles::DrawOnMinimap(CVertexArray& points, bool noLosTest) const
+{
+	if (positions.empty())
+		return;
+
+	points.EnlargeArrays(positions.size(), 0, VA_SIZE_C);
+
+	for (size_t i = 0, n = positions.size(); i < n; ++i) {
+		if (!IsVisible(positions[i], speeds[i], noLosTest))
+			continue;
+
+		points.AddVertexQC(positions[i], color4::green);
+	}
+}
@@ -0,0 +1,49 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef NANO_PARTICLES_H
+#define NANO_PARTICLES_H
+
+#include <vector>
+
+#include "System/float3.h"
+#include "System/Color.h"
+
+class CVertexArray;
+
+
+/**
+ * Nanospray of all builders and factories of one team. The particles
+ * only move in a straight line and die after a fixed number of frames,
+ * so unlike CNanoProjectile (which remains available to CEG's) they are
+ * not full projectiles but are kept in plain arrays, and updated and
+ * drawn in one loop per team.
+ */
+struct NanoParticles {
+public:
+	void Add(const float3 pos, const float3 speed, int deathFrame, const SColor color);
+	void Clear();
+
+	/// moves all particles, removes those that died before frameNum; returns how many were removed
+	size_t Update(int frameNum);
+
+	/**
+	 * @param noLosTest true if the viewer can see all particles of this team
+	 * (spectating or allied), otherwise each particle is checked against LOS
+	 */
+	void Draw(CVertexArray* va, bool noLosTest, bool drawReflection, bool drawRefraction) const;
+	void DrawOnMinimap(CVertexArray& points, bool noLosTest) const;
+
+	size_t size() const { return positions.size(); }
+	bool empty() const { return positions.empty(); }
+
+private:
+	bool IsVisible(const float3 pos, const float3 speed, bool noLosTest) const;
+
+private:
+	std::vector<float3> positions;
+	std::vector<float3> speeds;
+	std::vector<int> deathFrames;
+	std::vector<SColor> colors;
+};
+
+#endif /* NANO_PARTICLES_H */
@@ -21,6 +21,7 @@ public:
 
 	virtual void Draw(CVertexArray* va) override;
 	virtual void Update() override;
+	bool HasLocalUpdate() const override { return true; }
 	virtual void Init(const CUnit* owner, const float3& offset) override;
 
 	int GetProjectilesCount() const override;
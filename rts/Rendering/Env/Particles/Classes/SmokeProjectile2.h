@@ -26,6 +26,7 @@ public:
 	);
 
 	void Update() override;
+	bool HasLocalUpdate() const override { return true; }
 	void Draw(CVertexArray* va) override;
 	void Init(const CUnit* owner, const float3& offset) override;
 
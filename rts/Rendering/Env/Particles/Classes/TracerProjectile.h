@@ -20,6 +20,7 @@ public:
 
 	void Draw(CVertexArray* va) override;
 	void Update() override;
+	bool HasLocalUpdate() const override { return true; }
 	void Init(const CUnit* owner, const float3& offset) override;
 
 	int GetProjectilesCount() const override;
@@ -521,6 +521,18 @@ void CProjectileDrawer::DrawProjectilesMiniMap()
 		lines->DrawArrayC(GL_LINES);
 		points->DrawArrayC(GL_POINTS);
 	}
+
+	{
+		points->Initialize();
+
+		const NanoParticleContainer& container = projectileHandler->nanoParticles;
+
+		for (int teamNum = 0; teamNum < int(container.size()); teamNum++) {
+			container[teamNum].DrawOnMinimap(*points, gu->spectatingFullView || teamHandler->AlliedTeams(gu->myTeam, teamNum));
+		}
+
+		points->DrawArrayC(GL_POINTS);
+	}
 }
 
 void CProjectileDrawer::DrawFlyingPieces(int modelType)
@@ -556,6 +568,19 @@ void CProjectileDrawer::DrawFlyingPieces(int modelType)
 }
 
 
+void CProjectileDrawer::DrawNanoParticles(bool drawReflection, bool drawRefraction)
+{
+	const NanoParticleContainer& container = projectileHandler->nanoParticles;
+
+	// particles of our own and allied teams need no per-particle LOS test
+	for (int teamNum = 0; teamNum < int(container.size()); teamNum++) {
+		const bool noLosTst = gu->spectatingFullView || teamHandler->AlliedTeams(gu->myTeam, teamNum);
+
+		container[teamNum].Draw(fxVA, noLosTst, drawReflection, drawRefraction);
+	}
+}
+
+
 void CProjectileDrawer::Draw(bool drawReflection, bool drawRefraction) {
 	glPushAttrib(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
 	glDisable(GL_BLEND);
@@ -594,6 +619,8 @@ void CProjectileDrawer::Draw(bool drawReflection, bool drawRefraction) {
 		for (CProjectile* p: unsortedProjectiles) {
 			p->Draw(fxVA);
 		}
+
+		DrawNanoParticles(drawReflection, drawRefraction);
 	}
 
 	glEnable(GL_BLEND);
@@ -101,6 +101,7 @@ private:
 	void DrawProjectiles(int modelType, bool drawReflection, bool drawRefraction);
 	void DrawProjectilesShadow(int modelType);
 	void DrawFlyingPieces(int modelType);
+	void DrawNanoParticles(bool drawReflection, bool drawRefraction);
 
 	void DrawProjectilesSet(const std::vector<CProjectile*>& projectiles, bool drawReflection, bool drawRefraction);
 	static void DrawProjectilesSetShadow(const std::vector<CProjectile*>& projectiles);
@@ -555,11 +555,51 @@ void CTextWrap::RemergeColorCodes(std::list<word>* words, std::list<colorcode>&
 
 int CTextWrap::WrapInPlace(std::u8string& text, float _fontSize, float maxWidth, float maxHeight)
 {
-	// TODO make an option to insert '-' for word wrappings (and perhaps try to syllabificate)
-
 	if (_fontSize <= 0.0f)
 		_fontSize = GetSize();
 
+	// widgets and the console rewrap the same text with the same limits
+	// every frame; the result only depends on these and on glyph widths
+	// which never change for a font, so it can be looked up
+	const float params[] = {_fontSize, maxWidth, maxHeight};
+
+	std::string key(reinterpret_cast<const char*>(params), sizeof(params));
+	key.append(text);
+
+	std::lock_guard<spring::mutex> lock(wrapCacheMutex);
+
+	const auto it = wrapCacheIndex.find(key);
+
+	if (it != wrapCacheIndex.end()) {
+		wrapCache.splice(wrapCache.begin(), wrapCache, it->second);
+
+		text.assign(wrapCache.front().second.first);
+		return wrapCache.front().second.second;
+	}
+
+	if (wrapCache.size() >= WRAP_CACHE_SIZE) {
+		// recycle the least recently used entry
+		wrapCache.splice(wrapCache.begin(), wrapCache, std::prev(wrapCache.end()));
+		wrapCacheIndex.erase(wrapCache.front().first);
+		wrapCache.front().first = std::move(key);
+	} else {
+		wrapCache.emplace_front(std::move(key), WrapResult());
+	}
+
+	wrapCacheIndex[wrapCache.front().first] = wrapCache.begin();
+
+	WrapResult& result = wrapCache.front().second;
+
+	result.second = WrapInPlaceUncached(text, _fontSize, maxWidth, maxHeight);
+	result.first = text;
+	return result.second;
+}
+
+
+int CTextWrap::WrapInPlaceUncached(std::u8string& text, float _fontSize, float maxWidth, float maxHeight)
+{
+	// TODO make an option to insert '-' for word wrappings (and perhaps try to syllabificate)
+
 	const float maxWidthf  = maxWidth / _fontSize;
 	const float maxHeightf = maxHeight / _fontSize;
 
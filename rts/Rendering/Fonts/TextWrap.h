@@ -9,6 +9,8 @@
 #include "CFontTexture.h"
 #include "ustring.h"
 #include "System/Color.h"
+#include "System/UnorderedMap.hpp"
+#include "System/Threading/SpringThreading.h"
 
 
 class CTextWrap : public CFontTexture
@@ -77,8 +79,23 @@ private:
 
 	void WrapTextConsole(std::list<word>& words, float maxWidth, float maxHeight);
 
+	int WrapInPlaceUncached(std::u8string& text, float fontSize, float maxWidth, float maxHeight);
+
 	int WrapInPlace(std::u8string& text, float fontSize,  float maxWidth, float maxHeight = 1e9);
 	std::u8string Wrap(const std::u8string& text, float fontSize, float maxWidth, float maxHeight = 1e9);
+
+private:
+	//! wrapped text and its number of lines
+	typedef std::pair<std::string, int> WrapResult;
+	typedef std::list< std::pair<std::string, WrapResult> > WrapResultList;
+
+	//! max number of (text, size, limits) combinations whose wrapping is kept (LRU)
+	static const size_t WRAP_CACHE_SIZE = 512;
+
+	WrapResultList wrapCache; //! most recently used first
+	spring::unsynced_map<std::string, WrapResultList::iterator> wrapCacheIndex;
+
+	spring::mutex wrapCacheMutex;
 };
 
 // wrappers
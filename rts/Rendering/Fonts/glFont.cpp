@@ -5,6 +5,7 @@
 #include "FontLogSection.h"
 #include <stdarg.h>
 #include <stdexcept>
+#include <iterator>
 
 #include "Game/Camera.h"
 #include "Rendering/GlobalRendering.h"
@@ -38,15 +39,24 @@ static const float darkLuminosity = 0.05 +
 /*******************************************************************************/
 /*******************************************************************************/
 
+static inline SColor ToVertexColor(const float4& c)
+{
+	return (SColor(Clamp(c.x, 0.0f, 1.0f), Clamp(c.y, 0.0f, 1.0f), Clamp(c.z, 0.0f, 1.0f), Clamp(c.w, 0.0f, 1.0f)));
+}
+
 CglFont::CglFont(const std::string& fontfile, int size, int _outlinewidth, float _outlineweight)
 : CTextWrap(fontfile,size,_outlinewidth,_outlineweight)
 , fontPath(fontfile)
 , inBeginEnd(false)
 , autoOutlineColor(true)
 , setColor(false)
+, textColorSet(false)
 {
 	textColor    = white;
 	outlineColor = darkOutline;
+
+	textColorC    = ToVertexColor(textColor);
+	outlineColorC = ToVertexColor(outlineColor);
 }
 
 CglFont* CglFont::LoadFont(const std::string& fontFile, int size, int outlinewidth, float outlineweight)
@@ -80,10 +90,11 @@ static inline int SkipColorCodes(const std::u8string& text, T pos)
 
 
 template <typename T>
-static inline bool SkipColorCodesAndNewLines(const std::u8string& text, T* pos, float4* color, bool* colorChanged, int* skippedLines, float4* colorReset)
+static inline bool SkipColorCodesAndNewLines(const std::u8string& text, T* pos, float3* color, bool* colorSet, bool* colorReset, int* skippedLines)
 {
 	const size_t length = text.length();
-	(*colorChanged) = false;
+	(*colorSet) = false;
+	(*colorReset) = false;
 	(*skippedLines) = 0;
 	while (*pos < length) {
 		const char8_t& chr = text[*pos];
@@ -94,14 +105,14 @@ static inline bool SkipColorCodesAndNewLines(const std::u8string& text, T* pos,
 					(*color)[0] = text[(*pos) - 3] / 255.0f;
 					(*color)[1] = text[(*pos) - 2] / 255.0f;
 					(*color)[2] = text[(*pos) - 1] / 255.0f;
-					*colorChanged = true;
+					*colorSet = true;
 				}
 				break;
 
 			case CglFont::ColorResetIndicator:
 				(*pos)++;
-				(*color) = *colorReset;
-				*colorChanged = true;
+				*colorSet = false;
+				*colorReset = true;
 				break;
 
 			case 0x0d: // CR
@@ -125,12 +136,6 @@ static inline bool SkipColorCodesAndNewLines(const std::u8string& text, T* pos,
 }
 
 
-static inline void TextStripCallback(void* data)
-{
-	CglFont::ColorMap::iterator& sci = *reinterpret_cast<CglFont::ColorMap::iterator*>(data);
-	glColor4fv(*sci++);
-}
-
 
 /*******************************************************************************/
 /*******************************************************************************/
@@ -374,16 +379,11 @@ void CglFont::SetTextColor(const float4* color)
 	if (threadSafety)
 		vaMutex.lock();
 
-	if (inBeginEnd && !(*color == textColor)) {
-		if (va.drawIndex() == 0 && !stripTextColors.empty()) {
-			stripTextColors.back() = *color;
-		} else {
-			stripTextColors.push_back(*color);
-			va.EndStrip();
-		}
-	}
+	if (inBeginEnd && !(*color == textColor))
+		textColorSet = true;
 
 	textColor = *color;
+	textColorC = ToVertexColor(textColor);
 
 	if (threadSafety)
 		vaMutex.unlock();
@@ -398,16 +398,8 @@ void CglFont::SetOutlineColor(const float4* color)
 	if (threadSafety)
 		vaMutex.lock();
 
-	if (inBeginEnd && !(*color == outlineColor)) {
-		if (va2.drawIndex() == 0 && !stripOutlineColors.empty()) {
-			stripOutlineColors.back() = *color;
-		} else {
-			stripOutlineColors.push_back(*color);
-			va2.EndStrip();
-		}
-	}
-
 	outlineColor = *color;
+	outlineColorC = ToVertexColor(outlineColor);
 
 	if (threadSafety)
 		vaMutex.unlock();
@@ -462,12 +454,12 @@ void CglFont::Begin(const bool immediate, const bool resetColors)
 
 	inBeginEnd = true;
 
+	// every glyph vertex carries its own color, so one draw call covers all
+	// strings printed until End() regardless of (inline) color changes
+	textColorSet = false;
+
 	va.Initialize();
 	va2.Initialize();
-	stripTextColors.clear();
-	stripOutlineColors.clear();
-	stripTextColors.push_back(textColor);
-	stripOutlineColors.push_back(outlineColor);
 
 	glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
 	glDisable(GL_LIGHTING);
@@ -508,22 +500,13 @@ void CglFont::End()
 	glCallList(textureSpaceMatrix);
 	glMatrixMode(GL_MODELVIEW);
 
-	if (va2.drawIndex() > 0) {
-		if (stripOutlineColors.size() > 1) {
-			ColorMap::iterator sci = stripOutlineColors.begin();
-			va2.DrawArray2dT(GL_QUADS,TextStripCallback,&sci);
-		} else {
-			glColor4fv(outlineColor);
-			va2.DrawArray2dT(GL_QUADS);
-		}
-	}
+	va2.DrawArray2dTC(GL_QUADS);
 
-	if (stripTextColors.size() > 1) {
-		ColorMap::iterator sci = stripTextColors.begin();
-		va.DrawArray2dT(GL_QUADS,TextStripCallback,&sci);//FIXME calls a 0 length strip!
+	if (setColor || textColorSet) {
+		va.DrawArray2dTC(GL_QUADS);
 	} else {
-		if (setColor) glColor4fv(textColor);
-		va.DrawArray2dT(GL_QUADS);
+		// immediate undecorated print, keep the caller's glColor
+		va.DrawArray2dT(GL_QUADS, sizeof(float) * VA_SIZE_2DTC);
 	}
 
 	// pop texture matrix
@@ -542,126 +525,65 @@ void CglFont::End()
 /*******************************************************************************/
 /*******************************************************************************/
 
-void CglFont::RenderString(float x, float y, const float& scaleX, const float& scaleY, const std::string& str)
+const CglFont::TextLayout& CglFont::GetTextLayout(const std::string& str)
 {
-	/**
-	 * NOTE:
-	 * Font rendering does not use display lists, but VAs. It's actually faster
-	 * (450% faster with a 7600GT!) for these reasons:
-	 *
-	 * 1. When using DLs, we can not group multiple glyphs into one glBegin/End pair
-	 *    because glTranslatef can not go between such a pair.
-	 * 2. We can now eliminate all glPushMatrix/PopMatrix pairs related to font rendering
-	 *    because the transformations are calculated on the fly. These are just a couple of
-	 *    floating point multiplications and shouldn't be too expensive.
-	 */
-
-	const std::u8string& ustr = toustring(str);
-
-	const float startx = x;
-	const float lineHeight_ = scaleY * GetLineHeight();
-	const size_t length = str.length();
-
-	va.EnlargeArrays(length * 4, 0, VA_SIZE_2DT);
-
-	int i = 0;
-	int skippedLines = 0;
-	bool colorChanged = false;
-
-	// NOTE:
-	//   we need to keep track of the current and previous *characters*
-	//   rather than glyph *pointers*, because the previous-pointer can
-	//   become dangling as a result of GetGlyph calls
-	char32_t cc = 0;
-	char32_t pc = 0;
-
-	float4 newColor = textColor;
-
-	do {
-		// check for end-of-string
-		if (SkipColorCodesAndNewLines(ustr, &i, &newColor, &colorChanged, &skippedLines, &baseTextColor))
-			return;
-
-		cc = utf8::GetNextChar(str, i);
-
-		if (colorChanged) {
-			if (autoOutlineColor) {
-				SetColors(&newColor, nullptr);
-			} else {
-				SetTextColor(&newColor);
-			}
-		}
-
-
-		const GlyphInfo* cg = &GetGlyph(cc);
-		const GlyphInfo* pg = nullptr;
+	const auto it = layoutCacheIndex.find(str);
 
-		if (skippedLines > 0) {
-			x  = startx;
-			y -= (skippedLines * lineHeight_);
-		} else if (pc != 0) {
-			pg = &GetGlyph(pc);
-			x += (scaleX * GetKerning(*pg, *cg));
-		}
-
-		pg = cg;
-		pc = cc;
+	if (it != layoutCacheIndex.end()) {
+		layoutCache.splice(layoutCache.begin(), layoutCache, it->second);
+		return (layoutCache.front().second);
+	}
 
+	if (layoutCache.size() >= LAYOUT_CACHE_SIZE) {
+		// recycle the least recently used entry (keeps its buffers)
+		layoutCache.splice(layoutCache.begin(), layoutCache, std::prev(layoutCache.end()));
+		layoutCacheIndex.erase(layoutCache.front().first);
+		layoutCache.front().first = str;
+	} else {
+		layoutCache.emplace_front(str, TextLayout());
+	}
 
-		const auto&  tc = pg->texCord;
-		const float dx0 = (scaleX * pg->size.x0()) + x, dy0 = (scaleY * pg->size.y0()) + y;
-		const float dx1 = (scaleX * pg->size.x1()) + x, dy1 = (scaleY * pg->size.y1()) + y;
+	layoutCacheIndex[str] = layoutCache.begin();
 
-		va.AddVertexQ2dT(dx0, dy1, tc.x0(), tc.y1());
-		va.AddVertexQ2dT(dx0, dy0, tc.x0(), tc.y0());
-		va.AddVertexQ2dT(dx1, dy0, tc.x1(), tc.y0());
-		va.AddVertexQ2dT(dx1, dy1, tc.x1(), tc.y1());
-	} while (true);
+	BuildTextLayout(toustring(str), layoutCache.front().second);
+	return (layoutCache.front().second);
 }
 
 
-void CglFont::RenderStringShadow(float x, float y, const float& scaleX, const float& scaleY, const std::string& str)
+void CglFont::BuildTextLayout(const std::u8string& ustr, TextLayout& layout)
 {
-	#if 0
-	RenderString(x, y, scaleX, scaleY, str);
-	return;
-	#endif
+	layout.quads.clear();
+	layout.colorChanges.clear();
+	layout.quads.reserve(ustr.length());
 
-	const std::u8string& ustr = toustring(str);
+	layout.width = GetTextWidth_(ustr);
+	layout.height = GetTextHeight_(ustr, &layout.descender);
 
-	const float startx = x;
-	const float shiftX = scaleX * 0.1;
-	const float shiftY = scaleY * 0.1;
-	const float ssX = (scaleX / fontSize) * GetOutlineWidth();
-	const float ssY = (scaleY / fontSize) * GetOutlineWidth();
-	const float lineHeight_ = scaleY * GetLineHeight();
-	const size_t length = str.length();
-
-	va.EnlargeArrays(length * 4, 0, VA_SIZE_2DT);
-	va2.EnlargeArrays(length * 4, 0, VA_SIZE_2DT);
+	float x = 0.0f;
+	float y = 0.0f;
 
 	int i = 0;
 	int skippedLines = 0;
-	bool colorChanged = false;
 
+	// NOTE:
+	//   we need to keep track of the current and previous *characters*
+	//   rather than glyph *pointers*, because the previous-pointer can
+	//   become dangling as a result of GetGlyph calls
 	char32_t cc = 0;
 	char32_t pc = 0;
 
-	float4 newColor = textColor;
+	ColorChange cch;
 
 	do {
 		// check for end-of-string
-		if (SkipColorCodesAndNewLines(ustr, &i, &newColor, &colorChanged, &skippedLines, &baseTextColor))
+		if (SkipColorCodesAndNewLines(ustr, &i, &cch.rgb, &cch.setRGB, &cch.resetColor, &skippedLines))
 			return;
 
-		cc = utf8::GetNextChar(str, i);
+		cc = utf8::GetNextChar(ustr, i);
 
-		if (colorChanged) {
-			if (autoOutlineColor) {
-				SetColors(&newColor, nullptr);
-			} else {
-				SetTextColor(&newColor);
-			}
+		if (cch.setRGB || cch.resetColor) {
+			cch.quadIndex = layout.quads.size();
+			layout.colorChanges.push_back(cch);
 		}
 
 
@@ -669,71 +591,85 @@ void CglFont::RenderStringShadow(float x, float y, const float& scaleX, const fl
 		const GlyphInfo* pg = nullptr;
 
 		if (skippedLines > 0) {
-			x  = startx;
-			y -= (skippedLines * lineHeight_);
+			x  = 0.0f;
+			y -= (skippedLines * GetLineHeight());
 		} else if (pc != 0) {
 			pg = &GetGlyph(pc);
-			x += (scaleX * GetKerning(*pg, *cg));
+			x += GetKerning(*pg, *cg);
 		}
 
 		pg = cg;
 		pc = cc;
 
+		GlyphQuad q;
+		q.x0 = pg->size.x0() + x; q.y0 = pg->size.y0() + y;
+		q.x1 = pg->size.x1() + x; q.y1 = pg->size.y1() + y;
+		q.texCord = pg->texCord;
+		q.shadowTexCord = pg->shadowTexCord;
 
-		const auto&  tc = pg->texCord;
-		const auto& stc = pg->shadowTexCord;
-		const float dx0 = (scaleX * pg->size.x0()) + x, dy0 = (scaleY * pg->size.y0()) + y;
-		const float dx1 = (scaleX * pg->size.x1()) + x, dy1 = (scaleY * pg->size.y1()) + y;
-
-		// draw shadow
-		va2.AddVertexQ2dT(dx0 + shiftX - ssX, dy1 - shiftY - ssY, stc.x0(), stc.y1());
-		va2.AddVertexQ2dT(dx0 + shiftX - ssX, dy0 - shiftY + ssY, stc.x0(), stc.y0());
-		va2.AddVertexQ2dT(dx1 + shiftX + ssX, dy0 - shiftY + ssY, stc.x1(), stc.y0());
-		va2.AddVertexQ2dT(dx1 + shiftX + ssX, dy1 - shiftY - ssY, stc.x1(), stc.y1());
-
-		// draw the actual character
-		va.AddVertexQ2dT(dx0, dy1, tc.x0(), tc.y1());
-		va.AddVertexQ2dT(dx0, dy0, tc.x0(), tc.y0());
-		va.AddVertexQ2dT(dx1, dy0, tc.x1(), tc.y0());
-		va.AddVertexQ2dT(dx1, dy1, tc.x1(), tc.y1());
+		layout.quads.push_back(q);
 	} while (true);
 }
 
-void CglFont::RenderStringOutlined(float x, float y, const float& scaleX, const float& scaleY, const std::string& str)
+
+void CglFont::RenderLayout(float x, float y, const float& scaleX, const float& scaleY, const TextLayout& layout, const int options)
 {
-	#if 0
-	RenderString(x, y, scaleX, scaleY, str);
-	return;
-	#endif
+	/**
+	 * NOTE:
+	 * Font rendering does not use display lists, but VAs. It's actually faster
+	 * (450% faster with a 7600GT!) for these reasons:
+	 *
+	 * 1. When using DLs, we can not group multiple glyphs into one glBegin/End pair
+	 *    because glTranslatef can not go between such a pair.
+	 * 2. We can now eliminate all glPushMatrix/PopMatrix pairs related to font rendering
+	 *    because the transformations are calculated on the fly. These are just a couple of
+	 *    floating point multiplications and shouldn't be too expensive.
+	 *
+	 * The glyph run itself is cached per string (see GetTextLayout), so
+	 * only the scaling and translation have to be done per call.
+	 */
+	const bool outline = ((options & FONT_OUTLINE) != 0);
+	const bool shadow = ((options & FONT_SHADOW) != 0) && !outline;
+	const bool decorated = (outline || shadow);
 
-	const std::u8string& ustr = toustring(str);
+	// offsets of the outline/shadow quad corners relative to the glyph quad
+	float ox0 = 0.0f, ox1 = 0.0f;
+	float oy0 = 0.0f, oy1 = 0.0f;
 
-	const float startx = x;
-	const float shiftX = (scaleX / fontSize) * GetOutlineWidth();
-	const float shiftY = (scaleY / fontSize) * GetOutlineWidth();
-	const float lineHeight_ = scaleY * GetLineHeight();
-	const size_t length = str.length();
+	if (outline) {
+		const float shiftX = (scaleX / fontSize) * GetOutlineWidth();
+		const float shiftY = (scaleY / fontSize) * GetOutlineWidth();
 
-	va.EnlargeArrays(length * 4, 0, VA_SIZE_2DT);
-	va2.EnlargeArrays(length * 4, 0, VA_SIZE_2DT);
+		ox0 = -shiftX; ox1 = shiftX;
+		oy0 =  shiftY; oy1 = -shiftY;
+	}
+	if (shadow) {
+		const float shiftX = scaleX * 0.1;
+		const float shiftY = scaleY * 0.1;
+		const float ssX = (scaleX / fontSize) * GetOutlineWidth();
+		const float ssY = (scaleY / fontSize) * GetOutlineWidth();
+
+		ox0 = shiftX - ssX; ox1 =  shiftX + ssX;
+		oy0 = ssY - shiftY; oy1 = -shiftY - ssY;
+	}
 
-	int i = 0;
-	int skippedLines = 0;
-	bool colorChanged = false;
+	const size_t numQuads = layout.quads.size();
 
-	char32_t cc = 0;
-	char32_t pc = 0;
+	va.EnlargeArrays(numQuads * 4, 0, VA_SIZE_2DTC);
 
-	float4 newColor = textColor;
+	if (decorated)
+		va2.EnlargeArrays(numQuads * 4, 0, VA_SIZE_2DTC);
 
-	do {
-		// check for end-of-string
-		if (SkipColorCodesAndNewLines(ustr, &i, &newColor, &colorChanged, &skippedLines, &baseTextColor))
-			return;
+	auto cch = layout.colorChanges.cbegin();
+	float4 newColor = textColor;
 
-		cc = utf8::GetNextChar(str, i);
+	for (size_t n = 0; n < numQuads; n++) {
+		for (; cch != layout.colorChanges.cend() && cch->quadIndex == n; ++cch) {
+			if (cch->resetColor)
+				newColor = baseTextColor;
+			if (cch->setRGB)
+				newColor = cch->rgb;
 
-		if (colorChanged) {
 			if (autoOutlineColor) {
 				SetColors(&newColor, nullptr);
 			} else {
@@ -741,39 +677,27 @@ void CglFont::RenderStringOutlined(float x, float y, const float& scaleX, const
 			}
 		}
 
+		const GlyphQuad& q = layout.quads[n];
 
-		const GlyphInfo* cg = &GetGlyph(cc);
-		const GlyphInfo* pg = nullptr;
+		const auto&  tc = q.texCord;
+		const auto& stc = q.shadowTexCord;
+		const float dx0 = (scaleX * q.x0) + x, dy0 = (scaleY * q.y0) + y;
+		const float dx1 = (scaleX * q.x1) + x, dy1 = (scaleY * q.y1) + y;
 
-		if (skippedLines > 0) {
-			x  = startx;
-			y -= (skippedLines * lineHeight_);
-		} else if (pc != 0) {
-			pg = &GetGlyph(pc);
-			x += (scaleX * GetKerning(*pg, *cg));
+		// draw outline or shadow
+		if (decorated) {
+			va2.AddVertexQ2dTC(dx0 + ox0, dy1 + oy1, stc.x0(), stc.y1(), outlineColorC);
+			va2.AddVertexQ2dTC(dx0 + ox0, dy0 + oy0, stc.x0(), stc.y0(), outlineColorC);
+			va2.AddVertexQ2dTC(dx1 + ox1, dy0 + oy0, stc.x1(), stc.y0(), outlineColorC);
+			va2.AddVertexQ2dTC(dx1 + ox1, dy1 + oy1, stc.x1(), stc.y1(), outlineColorC);
 		}
 
-		pg = cg;
-		pc = cc;
-
-
-		const auto&  tc = pg->texCord;
-		const auto& stc = pg->shadowTexCord;
-		const float dx0 = (scaleX * pg->size.x0()) + x, dy0 = (scaleY * pg->size.y0()) + y;
-		const float dx1 = (scaleX * pg->size.x1()) + x, dy1 = (scaleY * pg->size.y1()) + y;
-
-		// draw outline
-		va2.AddVertexQ2dT(dx0 - shiftX, dy1 - shiftY, stc.x0(), stc.y1());
-		va2.AddVertexQ2dT(dx0 - shiftX, dy0 + shiftY, stc.x0(), stc.y0());
-		va2.AddVertexQ2dT(dx1 + shiftX, dy0 + shiftY, stc.x1(), stc.y0());
-		va2.AddVertexQ2dT(dx1 + shiftX, dy1 - shiftY, stc.x1(), stc.y1());
-
 		// draw the actual character
-		va.AddVertexQ2dT(dx0, dy1, tc.x0(), tc.y1());
-		va.AddVertexQ2dT(dx0, dy0, tc.x0(), tc.y0());
-		va.AddVertexQ2dT(dx1, dy0, tc.x1(), tc.y0());
-		va.AddVertexQ2dT(dx1, dy1, tc.x1(), tc.y1());
-	} while (true);
+		va.AddVertexQ2dTC(dx0, dy1, tc.x0(), tc.y1(), textColorC);
+		va.AddVertexQ2dTC(dx0, dy0, tc.x0(), tc.y0(), textColorC);
+		va.AddVertexQ2dTC(dx1, dy0, tc.x1(), tc.y0(), textColorC);
+		va.AddVertexQ2dTC(dx1, dy1, tc.x1(), tc.y1(), textColorC);
+	}
 }
 
 
@@ -793,6 +717,11 @@ void CglFont::glWorldPrint(const float3& p, const float size, const std::string&
 
 void CglFont::glPrint(float x, float y, float s, const int options, const std::string& text)
 {
+	if (threadSafety)
+		vaMutex.lock();
+
+	const TextLayout& layout = GetTextLayout(text);
+
 	// s := scale or absolute size?
 	if (options & FONT_SCALE) {
 		s *= fontSize;
@@ -808,9 +737,9 @@ void CglFont::glPrint(float x, float y, float s, const int options, const std::s
 
 	// horizontal alignment (FONT_LEFT is default)
 	if (options & FONT_CENTER) {
-		x -= sizeX * 0.5f * GetTextWidth(text);
+		x -= sizeX * 0.5f * layout.width;
 	} else if (options & FONT_RIGHT) {
-		x -= sizeX * GetTextWidth(text);
+		x -= sizeX * layout.width;
 	}
 
 
@@ -821,18 +750,15 @@ void CglFont::glPrint(float x, float y, float s, const int options, const std::s
 	} else if (options & FONT_DESCENDER) {
 		y -= sizeY * GetDescender();
 	} else if (options & FONT_VCENTER) {
-		float textDescender;
-		y -= sizeY * 0.5f * GetTextHeight(text,&textDescender);
-		y -= sizeY * 0.5f * textDescender;
+		y -= sizeY * 0.5f * layout.height;
+		y -= sizeY * 0.5f * layout.descender;
 	} else if (options & FONT_TOP) {
-		y -= sizeY * GetTextHeight(text);
+		y -= sizeY * layout.height;
 	} else if (options & FONT_ASCENDER) {
 		y -= sizeY * GetDescender();
 		y -= sizeY;
 	} else if (options & FONT_BOTTOM) {
-		float textDescender;
-		GetTextHeight(text,&textDescender);
-		y -= sizeY * textDescender;
+		y -= sizeY * layout.descender;
 	}
 
 	if (options & FONT_NEAREST) {
@@ -850,16 +776,8 @@ void CglFont::glPrint(float x, float y, float s, const int options, const std::s
 		Begin(!(options & (FONT_OUTLINE | FONT_SHADOW)));
 	}
 
-
-	// select correct decoration RenderString function
-	if (options & FONT_OUTLINE) {
-		RenderStringOutlined(x, y, sizeX, sizeY, text);
-	} else if (options & FONT_SHADOW) {
-		RenderStringShadow(x, y, sizeX, sizeY, text);
-	} else {
-		RenderString(x, y, sizeX, sizeY, text);
-	}
-
+	// outline takes precedence over shadow
+	RenderLayout(x, y, sizeX, sizeY, layout, options);
 
 	// immediate mode?
 	if (immediate) {
@@ -868,6 +786,9 @@ void CglFont::glPrint(float x, float y, float s, const int options, const std::s
 
 	// reset text & outline colors (if changed via in text colorcodes)
 	SetColors(&baseTextColor,&baseOutlineColor);
+
+	if (threadSafety)
+		vaMutex.unlock();
 }
 
 void CglFont::glPrintTable(float x, float y, float s, const int options, const std::string& text)
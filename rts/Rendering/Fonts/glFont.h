@@ -5,12 +5,15 @@
 
 #include <string>
 #include <deque>
+#include <list>
+#include <vector>
 
 #include "TextWrap.h"
 #include "ustring.h"
 
 #include "Rendering/GL/VertexArray.h"
 #include "System/float4.h"
+#include "System/UnorderedMap.hpp"
 #include "System/Threading/SpringThreading.h"
 
 #undef GetCharWidth // winapi.h
@@ -84,12 +87,41 @@ public:
 	static const char8_t ColorCodeIndicator  = 0xFF;
 	static const char8_t ColorResetIndicator = 0x08; //! =: '\\b'
 	static bool threadSafety;
+private:
+	//! glyph quad in unscaled font units, relative to the text origin
+	struct GlyphQuad {
+		float x0, y0;
+		float x1, y1;
+		IGlyphRect texCord;
+		IGlyphRect shadowTexCord;
+	};
+	//! inlined colorcode(s) preceding the quad at quadIndex
+	struct ColorChange {
+		size_t quadIndex;
+		float3 rgb;
+		bool resetColor; //! restart from baseTextColor
+		bool setRGB;
+	};
+	//! pre-built glyph run of a string, independent of size and position
+	struct TextLayout {
+		std::vector<GlyphQuad> quads;
+		std::vector<ColorChange> colorChanges;
+		float width;
+		float height;
+		float descender;
+	};
+	typedef std::list< std::pair<std::string, TextLayout> > TextLayoutList;
+
+	//! max number of strings whose layout is kept (LRU)
+	static const size_t LAYOUT_CACHE_SIZE = 2048;
+
 private:
 	static const float4* ChooseOutlineColor(const float4& textColor);
 
-	void RenderString(float x, float y, const float& scaleX, const float& scaleY, const std::string& str);
-	void RenderStringShadow(float x, float y, const float& scaleX, const float& scaleY, const std::string& str);
-	void RenderStringOutlined(float x, float y, const float& scaleX, const float& scaleY, const std::string& str);
+	const TextLayout& GetTextLayout(const std::string& str);
+	void BuildTextLayout(const std::u8string& ustr, TextLayout& layout);
+
+	void RenderLayout(float x, float y, const float& scaleX, const float& scaleY, const TextLayout& layout, const int options);
 
 private:
 	float GetTextWidth_(const std::u8string& text);
@@ -97,27 +129,29 @@ private:
 	static int GetTextNumLines_(const std::u8string& text);
 	static std::string StripColorCodes_(const std::u8string& text);
 
-public:
-	typedef std::vector<float4> ColorMap;
-
 private:
 	std::string fontPath;
 
-	ColorMap stripTextColors;
-	ColorMap stripOutlineColors;
-
 	CVertexArray va;
 	CVertexArray va2;
 
 	spring::recursive_mutex vaMutex;
 
+	TextLayoutList layoutCache; //! most recently used first
+	spring::unsynced_map<std::string, TextLayoutList::iterator> layoutCacheIndex;
+
 	bool inBeginEnd;
 	bool autoOutlineColor; //! auto select outline color for in-text-colorcodes
 	bool setColor; //! used for backward compability (so you can call glPrint (w/o BeginEnd and no shadow/outline!) and set the color yourself via glColor)
+	bool textColorSet; //! text color changed since Begin(), overrides !setColor
 
 	float4 textColor;
 	float4 outlineColor;
 
+	//! per-vertex copies of textColor and outlineColor
+	SColor textColorC;
+	SColor outlineColorC;
+
 	//! \::ColorResetIndicator will reset to those (they are the colors set when glPrint was called)
 	float4 baseTextColor;
 	float4 baseOutlineColor;
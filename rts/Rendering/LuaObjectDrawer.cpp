@@ -19,6 +19,7 @@
 #include "System/Config/ConfigHandler.h"
 #include "System/EventHandler.h"
 #include "System/SafeUtil.h"
+#include "System/Log/ILog.h"
 
 
 #define USE_OBJECT_RENDERING_BUCKETS
@@ -45,6 +46,8 @@ bool LuaObjectDrawer::bufferClearAllowed = false;
 
 int LuaObjectDrawer::binObjTeam = -1;
 
+LuaObjectDrawer::DrawPassStats LuaObjectDrawer::drawPassStats[2][LUAOBJ_LAST][LUAMAT_TYPE_COUNT];
+
 float LuaObjectDrawer::LODScale[LUAOBJ_LAST];
 float LuaObjectDrawer::LODScaleShadow[LUAOBJ_LAST];
 float LuaObjectDrawer::LODScaleReflection[LUAOBJ_LAST];
@@ -317,6 +320,11 @@ void LuaObjectDrawer::DrawMaterialBins(LuaObjType objType, LuaMatType matType, b
 {
 	const LuaMatBinSet& bins = luaMatHandler.GetBins(matType);
 
+	// the deferred and forward passes draw the same material types, keep
+	// their counters apart so neither overwrites the other's in a frame
+	DrawPassStats& stats = drawPassStats[deferredPass][objType][matType];
+	stats = DrawPassStats();
+
 	if (bins.empty())
 		return;
 
@@ -338,8 +346,21 @@ void LuaObjectDrawer::DrawMaterialBins(LuaObjType objType, LuaMatType matType, b
 	const LuaMaterial* prevMat = &LuaMaterial::defMat;
 
 	for (auto it = bins.cbegin(); it != bins.cend(); ++it) {
-		DrawMaterialBin(*it, prevMat, objType, matType, deferredPass, inAlphaBin);
-		prevMat = *it;
+		const LuaMatBin* currBin = *it;
+
+		// bins are persistent and sorted by state-switch cost, but most
+		// of them can be empty in any given pass (e.g. LOD or visibility)
+		// so do not switch state to and away from those
+		if (currBin->GetObjects(objType).empty()) {
+			stats.numSkippedBins++;
+			continue;
+		}
+
+		stats.numBins++;
+		stats.numShaderBinds += (LuaMatShader::Compare(currBin->shaders[deferredPass], prevMat->shaders[deferredPass]) != 0);
+
+		DrawMaterialBin(currBin, prevMat, objType, matType, deferredPass, inAlphaBin, stats);
+		prevMat = currBin;
 	}
 
 	LuaMaterial::defMat.Execute(*prevMat, deferredPass);
@@ -357,7 +378,8 @@ void LuaObjectDrawer::DrawMaterialBin(
 	LuaObjType objType,
 	LuaMatType matType,
 	bool deferredPass,
-	bool alphaMatBin
+	bool alphaMatBin,
+	DrawPassStats& stats
 ) {
 	currBin->Execute(*prevMat, deferredPass);
 
@@ -382,7 +404,11 @@ void LuaObjectDrawer::DrawMaterialBin(
 		maxObjTeam = std::max(maxObjTeam, obj->team);
 	}
 
+	stats.numObjects += objects.size();
+
 	for (int objTeam = minObjTeam; objTeam <= maxObjTeam; objTeam++) {
+		stats.numTeamChanges += (!objectBuckets[objTeam].empty());
+
 		for (const CSolidObject* obj: objectBuckets[objTeam]) {
 			const LuaObjectMaterialData* matData = obj->GetLuaMaterialData();
 			const LuaObjectLODMaterial* lodMat = matData->GetLuaLODMaterial(matType);
@@ -396,7 +422,11 @@ void LuaObjectDrawer::DrawMaterialBin(
 
 	#else
 
+	stats.numObjects += objects.size();
+
 	for (const CSolidObject* obj: objects) {
+		stats.numTeamChanges += (obj->team != binObjTeam);
+
 		const LuaObjectMaterialData* matData = obj->GetLuaMaterialData();
 		const LuaObjectLODMaterial* lodMat = matData->GetLuaLODMaterial(matType);
 
@@ -446,6 +476,27 @@ void LuaObjectDrawer::DrawBinObject(
 }
 
 
+void LuaObjectDrawer::PrintDrawPassStats()
+{
+	static const char* passNames[2] = {"forward", "deferred"};
+	static const char* objTypeNames[LUAOBJ_LAST] = {"units", "features"};
+
+	for (int deferredPass = 0; deferredPass < 2; deferredPass++) {
+		for (int objType = LUAOBJ_UNIT; objType < LUAOBJ_LAST; objType++) {
+			for (int matType = 0; matType < LUAMAT_TYPE_COUNT; matType++) {
+				const DrawPassStats& s = drawPassStats[deferredPass][objType][matType];
+
+				LOG(
+					"[LuaObjectDrawer::%s][%s][%s][matType=%d] bins=%u (skipped=%u) shaderBinds=%u teamChanges=%u objects=%u",
+					__func__, passNames[deferredPass], objTypeNames[objType], matType,
+					s.numBins, s.numSkippedBins, s.numShaderBinds, s.numTeamChanges, s.numObjects
+				);
+			}
+		}
+	}
+}
+
+
 void LuaObjectDrawer::DrawDeferredPass(LuaObjType objType)
 {
 	if (!drawDeferredEnabled)
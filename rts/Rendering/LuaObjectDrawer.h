@@ -21,6 +21,17 @@ class LuaMatShader;
 // note: custom materials can use standard shaders!
 //
 class LuaObjectDrawer {
+public:
+	// counters gathered during the last DrawMaterialBins call per pass (forward
+	// or deferred), object and material type
+	struct DrawPassStats {
+		unsigned int numBins;        // bins drawn, each is one material state switch
+		unsigned int numSkippedBins; // bins without objects, no state was switched for these
+		unsigned int numShaderBinds; // state switches that also changed the shader
+		unsigned int numTeamChanges; // per-object team-color updates
+		unsigned int numObjects;
+	};
+
 public:
 	static bool InDrawPass() { return inDrawPass; }
 	static void DrawDeferredPass(LuaObjType objType);
@@ -50,6 +61,9 @@ public:
 
 	static int GetBinObjTeam() { return binObjTeam; }
 
+	static const DrawPassStats& GetDrawPassStats(bool deferredPass, LuaObjType objType, LuaMatType matType) { return drawPassStats[deferredPass][objType][matType]; }
+	static void PrintDrawPassStats();
+
 	static float GetLODScale          (int objType) { return (LODScale[objType]                              ); }
 	static float GetLODScaleShadow    (int objType) { return (LODScale[objType] * LODScaleShadow    [objType]); }
 	static float GetLODScaleReflection(int objType) { return (LODScale[objType] * LODScaleReflection[objType]); }
@@ -77,7 +91,8 @@ private:
 		LuaObjType objType,
 		LuaMatType matType,
 		bool deferredPass,
-		bool alphaMatBin
+		bool alphaMatBin,
+		DrawPassStats& stats
 	);
 
 	static void DrawBinObject(
@@ -112,6 +127,8 @@ private:
 	// Lua shaders do not have any uniform caching yet)
 	static int binObjTeam;
 
+	static DrawPassStats drawPassStats[2][LUAOBJ_LAST][LUAMAT_TYPE_COUNT];
+
 	static float LODScale[LUAOBJ_LAST];
 	static float LODScaleShadow[LUAOBJ_LAST];
 	static float LODScaleReflection[LUAOBJ_LAST];
@@ -18,6 +18,7 @@ CInfoTextureHandler::CInfoTextureHandler()
 	if (infoTextureHandler == nullptr)
 		infoTextureHandler = this;
 
+	// registration order is update order (see Update)
 	AddInfoTexture(infoTex = new CInfoTextureCombiner());
 	AddInfoTexture(new CLosTexture());
 	AddInfoTexture(new CAirLosTexture());
@@ -36,8 +37,8 @@ CInfoTextureHandler::CInfoTextureHandler()
 
 CInfoTextureHandler::~CInfoTextureHandler()
 {
-	for (auto& pitex: infoTextures) {
-		delete pitex.second;
+	for (CPboInfoTexture* itex: infoTexturesOrdered) {
+		delete itex;
 	}
 	infoTextureHandler = nullptr;
 }
@@ -46,6 +47,7 @@ CInfoTextureHandler::~CInfoTextureHandler()
 void CInfoTextureHandler::AddInfoTexture(CPboInfoTexture* itex)
 {
 	infoTextures[itex->GetName()] = itex;
+	infoTexturesOrdered.push_back(itex);
 }
 
 
@@ -125,9 +127,9 @@ void CInfoTextureHandler::Update()
 	glActiveTexture(GL_TEXTURE0);
 	glEnable(GL_TEXTURE_2D);
 
-	for (auto& p: infoTextures) {
-		CPboInfoTexture* tex = p.second;
-
+	// walk in registration order; the radar texture samples the los
+	// texture when redrawing its dirty rect, so los has to go first
+	for (CPboInfoTexture* tex: infoTexturesOrdered) {
 		// force first update except for combiner; hides visible uninitialized texmem
 		if ((firstUpdate && tex != infoTex) || tex->IsUpdateNeeded())
 			tex->Update();
@@ -4,6 +4,7 @@
 #define _INFO_TEXTURE_HANDLER_H
 
 #include <string>
+#include <vector>
 
 #include "Rendering/GL/myGL.h"
 #include "Rendering/Map/InfoTexture/IInfoTextureHandler.h"
@@ -49,6 +50,7 @@ protected:
 	bool firstUpdate =  true;
 
 	spring::unordered_map<std::string, CPboInfoTexture*> infoTextures;
+	std::vector<CPboInfoTexture*> infoTexturesOrdered;
 
 	// special; always non-NULL at runtime
 	CInfoTextureCombiner* infoTex = nullptr;
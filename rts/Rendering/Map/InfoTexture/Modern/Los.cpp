@@ -14,6 +14,9 @@
 CLosTexture::CLosTexture()
 : CPboInfoTexture("los")
 , uploadTex(0)
+, dirtyRectConsumer(losHandler->los.AddDirtyRectConsumer())
+, viewAllyTeam(-1)
+, viewGlobalLOS(false)
 {
 	texSize = losHandler->los.size;
 	texChannels = 1;
@@ -97,25 +100,58 @@ CLosTexture::~CLosTexture()
 }
 
 
+void CLosTexture::PollDirtyRect()
+{
+	const int allyTeam = gu->myAllyTeam;
+	const bool globalLOS = losHandler->globalLOS[allyTeam];
+	const SRectangle rect = losHandler->los.ConsumeDirtyRect(dirtyRectConsumer, allyTeam);
+
+	if (allyTeam != viewAllyTeam || globalLOS != viewGlobalLOS) {
+		viewAllyTeam = allyTeam;
+		viewGlobalLOS = globalLOS;
+		SetFullyDirty();
+		return;
+	}
+
+	// with globalLOS everything stays visible, no matter what units do
+	if (!globalLOS)
+		AddDirtyRect(rect, losHandler->los.size);
+}
+
+
+bool CLosTexture::IsUpdateNeeded()
+{
+	PollDirtyRect();
+	return IsDirty();
+}
+
+
 void CLosTexture::UpdateCPU()
 {
+	const SRectangle rect = dirtyRect;
+	const int rectSizeX = rect.GetWidth();
+
 	infoTexPBO.Bind();
 	auto infoTexMem = reinterpret_cast<unsigned char*>(infoTexPBO.MapBuffer());
 
+	// only convert the changed texels, packed into rows of rectSizeX
 	if (!losHandler->globalLOS[gu->myAllyTeam]) {
 		const unsigned short* myLos = &losHandler->los.losMaps[gu->myAllyTeam].front();
-		for (int y = 0; y < texSize.y; ++y) {
-			for (int x = 0; x < texSize.x; ++x) {
-				infoTexMem[y * texSize.x + x] = (myLos[y * texSize.x + x] != 0) ? 255 : 0;
+		for (int y = rect.z1; y < rect.z2; ++y) {
+			const unsigned short* srcRow = &myLos[y * texSize.x + rect.x1];
+			unsigned char* dstRow = &infoTexMem[(y - rect.z1) * rectSizeX];
+
+			for (int x = 0; x < rectSizeX; ++x) {
+				dstRow[x] = (srcRow[x] != 0) ? 255 : 0;
 			}
 		}
 	} else {
-		memset(infoTexMem, 255, texSize.x * texSize.y);
+		memset(infoTexMem, 255, rect.GetArea());
 	}
 
 	infoTexPBO.UnmapBuffer();
 	glBindTexture(GL_TEXTURE_2D, texture);
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texSize.x, texSize.y, GL_RED, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr());
+	glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x1, rect.z1, rectSizeX, rect.GetHeight(), GL_RED, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr());
 	glGenerateMipmap(GL_TEXTURE_2D);
 	infoTexPBO.Invalidate();
 	infoTexPBO.Unbind();
@@ -124,8 +160,17 @@ void CLosTexture::UpdateCPU()
 
 void CLosTexture::Update()
 {
-	if (!fbo.IsValid() || !shader->IsValid() || uploadTex == 0)
-		return UpdateCPU();
+	// the handler forces a first update without asking IsUpdateNeeded
+	PollDirtyRect();
+
+	if (!IsDirty())
+		return;
+
+	if (!fbo.IsValid() || !shader->IsValid() || uploadTex == 0) {
+		UpdateCPU();
+		dirtyRect = SRectangle();
+		return;
+	}
 
 	if (losHandler->globalLOS[gu->myAllyTeam]) {
 		fbo.Bind();
@@ -137,26 +182,35 @@ void CLosTexture::Update()
 
 		glBindTexture(GL_TEXTURE_2D, texture);
 		glGenerateMipmap(GL_TEXTURE_2D);
+		dirtyRect = SRectangle();
 		return;
 	}
 
+	const SRectangle rect = dirtyRect;
+	const int rectSizeX = rect.GetWidth();
+
 	infoTexPBO.Bind();
-	auto infoTexMem = reinterpret_cast<unsigned char*>(infoTexPBO.MapBuffer());
+	auto infoTexMem = reinterpret_cast<unsigned short*>(infoTexPBO.MapBuffer());
 	const unsigned short* myLos = &losHandler->los.losMaps[gu->myAllyTeam].front();
-	memcpy(infoTexMem, myLos, texSize.x * texSize.y * texChannels * sizeof(short));
+	for (int y = rect.z1; y < rect.z2; ++y) {
+		memcpy(&infoTexMem[(y - rect.z1) * rectSizeX], &myLos[y * texSize.x + rect.x1], rectSizeX * sizeof(short));
+	}
 	infoTexPBO.UnmapBuffer();
 
 	//Trick: Upload the ushort as 2 ubytes, and then check both for `!=0` in the shader.
 	// Faster than doing it on the CPU! And uploading it as shorts would be slow, cause the GPU
 	// has no native support for them and so the transformation would happen on the CPU, too.
+	// Texels outside of rect still hold the (unchanged) data of previous uploads.
 	glBindTexture(GL_TEXTURE_2D, uploadTex);
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texSize.x, texSize.y, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr());
+	glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x1, rect.z1, rectSizeX, rect.GetHeight(), GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr());
 	infoTexPBO.Invalidate();
 	infoTexPBO.Unbind();
 
 	// do post-processing on the gpu (los-checking & scaling)
 	fbo.Bind();
 	glViewport(0,0, texSize.x, texSize.y);
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(rect.x1, rect.z1, rectSizeX, rect.GetHeight());
 	shader->Enable();
 	glDisable(GL_BLEND);
 	glBegin(GL_QUADS);
@@ -166,10 +220,12 @@ void CLosTexture::Update()
 		glVertex2f(+1.f, -1.f);
 	glEnd();
 	shader->Disable();
+	glDisable(GL_SCISSOR_TEST);
 	glViewport(globalRendering->viewPosX,0,globalRendering->viewSizeX,globalRendering->viewSizeY);
 	FBO::Unbind();
 
 	// generate mipmaps
 	glBindTexture(GL_TEXTURE_2D, texture);
 	glGenerateMipmap(GL_TEXTURE_2D);
+	dirtyRect = SRectangle();
 }
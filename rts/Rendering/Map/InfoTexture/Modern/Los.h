@@ -20,15 +20,20 @@ public:
 
 public:
 	void Update() override;
-	bool IsUpdateNeeded() override { return true; }
+	bool IsUpdateNeeded() override;
 
 private:
 	void UpdateCPU();
+	void PollDirtyRect();
 
 private:
 	FBO fbo;
 	GLuint uploadTex;
 	Shader::IProgramObject* shader;
+
+	int dirtyRectConsumer;
+	int viewAllyTeam;
+	bool viewGlobalLOS;
 };
 
 #endif // _LOS_TEXTURE_H
@@ -2,6 +2,8 @@
 
 #include "PboInfoTexture.h"
 
+#include <algorithm>
+
 
 CPboInfoTexture::CPboInfoTexture(const std::string& _name)
 {
@@ -15,3 +17,29 @@ CPboInfoTexture::~CPboInfoTexture()
 {
 	glDeleteTextures(1, &texture);
 }
+
+
+void CPboInfoTexture::AddDirtyRect(SRectangle rect, int2 rectSize)
+{
+	if (rect.GetArea() <= 0)
+		return;
+
+	// rescale into texture-space (rounding outwards), then align
+	// the x-bounds to 4 texels so rows of sub-image uploads never
+	// need a different GL_UNPACK_ALIGNMENT
+	rect.x1 = ((rect.x1 * texSize.x) / rectSize.x) & ~3;
+	rect.z1 =  (rect.z1 * texSize.y) / rectSize.y;
+	rect.x2 = ((rect.x2 * texSize.x + rectSize.x - 1) / rectSize.x + 3) & ~3;
+	rect.z2 =  (rect.z2 * texSize.y + rectSize.y - 1) / rectSize.y;
+	rect.ClampIn(SRectangle(0, 0, texSize.x, texSize.y));
+
+	if (!IsDirty()) {
+		dirtyRect = rect;
+		return;
+	}
+
+	dirtyRect.x1 = std::min(dirtyRect.x1, rect.x1);
+	dirtyRect.z1 = std::min(dirtyRect.z1, rect.z1);
+	dirtyRect.x2 = std::max(dirtyRect.x2, rect.x2);
+	dirtyRect.z2 = std::max(dirtyRect.z2, rect.z2);
+}
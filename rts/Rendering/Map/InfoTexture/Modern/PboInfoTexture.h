@@ -5,6 +5,7 @@
 
 #include "Rendering/Map/InfoTexture/InfoTexture.h"
 #include "Rendering/GL/PBO.h"
+#include "System/Rectangle.h"
 
 
 
@@ -19,8 +20,17 @@ public:
 	virtual void Update() = 0;
 	virtual bool IsUpdateNeeded() = 0;
 
+protected:
+	/// grows dirtyRect by <rect>, given in a <rectSize>-sized grid (e.g. a LOS-map)
+	void AddDirtyRect(SRectangle rect, int2 rectSize);
+	void SetFullyDirty() { dirtyRect = SRectangle(0, 0, texSize.x, texSize.y); }
+	bool IsDirty() const { return (dirtyRect.GetArea() > 0); }
+
 protected:
 	PBO infoTexPBO;
+
+	// texels that still need to be re-uploaded by the next Update
+	SRectangle dirtyRect;
 };
 
 #endif // _PBO_INFO_TEXTURE_H
@@ -17,6 +17,11 @@ CRadarTexture::CRadarTexture()
 : CPboInfoTexture("radar")
 , uploadTexRadar(0)
 , uploadTexJammer(0)
+, losRectConsumer(losHandler->los.AddDirtyRectConsumer())
+, radarRectConsumer(losHandler->radar.AddDirtyRectConsumer())
+, jammerRectConsumer(losHandler->jammer.AddDirtyRectConsumer())
+, viewAllyTeam(-1)
+, viewGlobalLOS(false)
 {
 	texSize = losHandler->radar.size;
 	texChannels = 2;
@@ -119,11 +124,49 @@ CRadarTexture::~CRadarTexture()
 }
 
 
+void CRadarTexture::PollDirtyRect()
+{
+	const int allyTeam = gu->myAllyTeam;
+	const int jammerAllyTeam = modInfo.separateJammers ? allyTeam : 0;
+	const bool globalLOS = losHandler->globalLOS[allyTeam];
+
+	// jammed texels are only shown inside los, so its changes matter too
+	const SRectangle losRect    = losHandler->los.ConsumeDirtyRect(losRectConsumer, allyTeam);
+	const SRectangle radarRect  = losHandler->radar.ConsumeDirtyRect(radarRectConsumer, allyTeam);
+	const SRectangle jammerRect = losHandler->jammer.ConsumeDirtyRect(jammerRectConsumer, jammerAllyTeam);
+
+	if (allyTeam != viewAllyTeam || globalLOS != viewGlobalLOS) {
+		viewAllyTeam = allyTeam;
+		viewGlobalLOS = globalLOS;
+		SetFullyDirty();
+		return;
+	}
+
+	if (globalLOS)
+		return;
+
+	AddDirtyRect(losRect, losHandler->los.size);
+	AddDirtyRect(radarRect, losHandler->radar.size);
+	AddDirtyRect(jammerRect, losHandler->jammer.size);
+}
+
+
+bool CRadarTexture::IsUpdateNeeded()
+{
+	PollDirtyRect();
+	return IsDirty();
+}
+
+
 void CRadarTexture::UpdateCPU()
 {
+	const SRectangle rect = dirtyRect;
+	const int rectSizeX = rect.GetWidth();
+
 	infoTexPBO.Bind();
 	auto infoTexMem = reinterpret_cast<unsigned char*>(infoTexPBO.MapBuffer());
 
+	// only convert the changed texels, packed into rows of rectSizeX
 	if (!losHandler->globalLOS[gu->myAllyTeam]) {
 		const int jammerAllyTeam = modInfo.separateJammers ? gu->myAllyTeam : 0;
 
@@ -131,26 +174,24 @@ void CRadarTexture::UpdateCPU()
 
 		const unsigned short* myRadar  = &losHandler->radar.losMaps[gu->myAllyTeam].front();
 		const unsigned short* myJammer = &losHandler->jammer.losMaps[jammerAllyTeam].front();
-		for (int y = 0; y < texSize.y; ++y) {
-			for (int x = 0; x < texSize.x; ++x) {
+		for (int y = rect.z1; y < rect.z2; ++y) {
+			for (int x = rect.x1; x < rect.x2; ++x) {
 				const int idx = y * texSize.x + x;
-				infoTexMem[idx * 2 + 0] = ( myRadar[idx] != 0) ? 255 : 0;
-				infoTexMem[idx * 2 + 1] = (myJammer[idx] != 0 && myLos[idx] != 0) ? 255 : 0;
+				const int dst = (y - rect.z1) * rectSizeX + (x - rect.x1);
+				infoTexMem[dst * 2 + 0] = ( myRadar[idx] != 0) ? 255 : 0;
+				infoTexMem[dst * 2 + 1] = (myJammer[idx] != 0 && myLos[idx] != 0) ? 255 : 0;
 			}
 		}
 	} else {
-		for (int y = 0; y < texSize.y; ++y) {
-			for (int x = 0; x < texSize.x; ++x) {
-				const int idx = y * texSize.x + x;
-				infoTexMem[idx * 2 + 0] = 255;
-				infoTexMem[idx * 2 + 1] = 0;
-			}
+		for (int i = 0, n = rect.GetArea(); i < n; ++i) {
+			infoTexMem[i * 2 + 0] = 255;
+			infoTexMem[i * 2 + 1] = 0;
 		}
 	}
 
 	infoTexPBO.UnmapBuffer();
 	glBindTexture(GL_TEXTURE_2D, texture);
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texSize.x, texSize.y, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr());
+	glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x1, rect.z1, rectSizeX, rect.GetHeight(), GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr());
 	infoTexPBO.Invalidate();
 	infoTexPBO.Unbind();
 }
@@ -158,8 +199,17 @@ void CRadarTexture::UpdateCPU()
 
 void CRadarTexture::Update()
 {
-	if (!fbo.IsValid() || !shader->IsValid() || uploadTexRadar == 0 || uploadTexJammer == 0)
-		return UpdateCPU();
+	// the handler forces a first update without asking IsUpdateNeeded
+	PollDirtyRect();
+
+	if (!IsDirty())
+		return;
+
+	if (!fbo.IsValid() || !shader->IsValid() || uploadTexRadar == 0 || uploadTexJammer == 0) {
+		UpdateCPU();
+		dirtyRect = SRectangle();
+		return;
+	}
 
 	if (losHandler->globalLOS[gu->myAllyTeam]) {
 		fbo.Bind();
@@ -171,37 +221,47 @@ void CRadarTexture::Update()
 
 		glBindTexture(GL_TEXTURE_2D, texture);
 		glGenerateMipmap(GL_TEXTURE_2D);
+		dirtyRect = SRectangle();
 		return;
 	}
 
 	const int jammerAllyTeam = modInfo.separateJammers ? gu->myAllyTeam : 0;
 
+	const SRectangle rect = dirtyRect;
+	const int rectSizeX = rect.GetWidth();
+	const int rectSizeY = rect.GetHeight();
+
 	infoTexPBO.Bind();
-	const size_t arraySize = texSize.x * texSize.y * sizeof(unsigned short);
+	const size_t arraySize = rect.GetArea() * sizeof(unsigned short);
 	auto infoTexMem = reinterpret_cast<unsigned char*>(infoTexPBO.MapBuffer());
 	const unsigned short* myRadar  = &losHandler->radar.losMaps[gu->myAllyTeam].front();
 	const unsigned short* myJammer = &losHandler->jammer.losMaps[jammerAllyTeam].front();
-	memcpy(infoTexMem,  myRadar, arraySize);
-	infoTexMem += arraySize;
-	memcpy(infoTexMem, myJammer, arraySize);
+	for (int y = rect.z1; y < rect.z2; ++y) {
+		const size_t rowOffset = (y - rect.z1) * rectSizeX * sizeof(unsigned short);
+		memcpy(infoTexMem             + rowOffset,  &myRadar[y * texSize.x + rect.x1], rectSizeX * sizeof(unsigned short));
+		memcpy(infoTexMem + arraySize + rowOffset, &myJammer[y * texSize.x + rect.x1], rectSizeX * sizeof(unsigned short));
+	}
 	infoTexPBO.UnmapBuffer();
 
 	//Trick: Upload the ushort as 2 ubytes, and then check both for `!=0` in the shader.
 	// Faster than doing it on the CPU! And uploading it as shorts would be slow, cause the GPU
 	// has no native support for them and so the transformation would happen on the CPU, too.
+	// Texels outside of rect still hold the (unchanged) data of previous uploads.
 	glActiveTexture(GL_TEXTURE1);
 	glEnable(GL_TEXTURE_2D);
 	glBindTexture(GL_TEXTURE_2D, uploadTexRadar);
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texSize.x, texSize.y, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr());
+	glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x1, rect.z1, rectSizeX, rectSizeY, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr());
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(GL_TEXTURE_2D, uploadTexJammer);
-	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texSize.x, texSize.y, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr(arraySize));
+	glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x1, rect.z1, rectSizeX, rectSizeY, GL_RG, GL_UNSIGNED_BYTE, infoTexPBO.GetPtr(arraySize));
 	infoTexPBO.Invalidate();
 	infoTexPBO.Unbind();
 
 	// do post-processing on the gpu (los-checking & scaling)
 	fbo.Bind();
 	glViewport(0,0, texSize.x, texSize.y);
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(rect.x1, rect.z1, rectSizeX, rectSizeY);
 	shader->Enable();
 	glDisable(GL_BLEND);
 	glActiveTexture(GL_TEXTURE2);
@@ -214,6 +274,7 @@ void CRadarTexture::Update()
 		glVertex2f(+1.f, -1.f);
 	glEnd();
 	shader->Disable();
+	glDisable(GL_SCISSOR_TEST);
 	glViewport(globalRendering->viewPosX,0,globalRendering->viewSizeX,globalRendering->viewSizeY);
 	FBO::Unbind();
 
@@ -226,4 +287,5 @@ void CRadarTexture::Update()
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(GL_TEXTURE_2D, texture);
 	glGenerateMipmap(GL_TEXTURE_2D);
+	dirtyRect = SRectangle();
 }
@@ -21,16 +21,23 @@ public:
 
 public:
 	void Update() override;
-	bool IsUpdateNeeded() override { return true; }
+	bool IsUpdateNeeded() override;
 
 private:
 	void UpdateCPU();
+	void PollDirtyRect();
 
 private:
 	FBO fbo;
 	GLuint uploadTexRadar;
 	GLuint uploadTexJammer;
 	Shader::IProgramObject* shader;
+
+	int losRectConsumer;
+	int radarRectConsumer;
+	int jammerRectConsumer;
+	int viewAllyTeam;
+	bool viewGlobalLOS;
 };
 
 #endif // _RADAR_TEXTURE_H
@@ -58,6 +58,7 @@ void S3DModel::DeletePieces()
 	}
 
 	pieces.clear();
+	spring::SafeDelete(bposeInstance);
 }
 
 
@@ -287,20 +288,43 @@ void LocalModel::SetModel(const S3DModel* model, bool initialize)
 
 	assert(pieces.empty());
 
-	pieces.clear();
-	pieces.reserve(model->numPieces);
+	if (model->bposeInstance == nullptr) {
+		LocalModel* bposeModel = new LocalModel();
+
+		bposeModel->pieces.reserve(model->numPieces);
+		bposeModel->CreateLocalModelPieces(model->GetRootPiece());
+
+		// must recursively update matrices here too: for features
+		// LocalModel::Update is never called, but they might have
+		// baked piece rotations (in the case of .dae)
+		bposeModel->pieces[0].UpdateChildMatricesRec(false);
+		bposeModel->UpdateBoundingVolume();
 
-	CreateLocalModelPieces(model->GetRootPiece());
+		model->bposeInstance = bposeModel;
+	}
 
-	// must recursively update matrices here too: for features
-	// LocalModel::Update is never called, but they might have
-	// baked piece rotations (in the case of .dae)
-	pieces[0].UpdateChildMatricesRec(false);
-	UpdateBoundingVolume();
+	// every new instance starts out in the same state, copy it
+	CopyLocalModelPieces(model->bposeInstance);
 
 	assert(pieces.size() == model->numPieces);
 }
 
+void LocalModel::CopyLocalModelPieces(const LocalModel* bposeModel)
+{
+	pieces = bposeModel->pieces;
+	boundingVolume = bposeModel->boundingVolume;
+
+	// relocate the tree links from the bind-pose instance to our own pieces
+	for (LocalModelPiece& lmp: pieces) {
+		if (lmp.parent != nullptr)
+			lmp.parent = &pieces[lmp.parent->GetLModelPieceIndex()];
+
+		for (LocalModelPiece*& lmpChild: lmp.children) {
+			lmpChild = &pieces[lmpChild->GetLModelPieceIndex()];
+		}
+	}
+}
+
 LocalModelPiece* LocalModel::CreateLocalModelPieces(const S3DModelPiece* mpParent)
 {
 	LocalModelPiece* lmpChild = nullptr;
@@ -207,6 +207,8 @@ struct S3DModel
 		, mins(DEF_MIN_SIZE)
 		, maxs(DEF_MAX_SIZE)
 		, relMidPos(ZeroVector)
+
+		, bposeInstance(nullptr)
 	{
 	}
 
@@ -233,6 +235,9 @@ struct S3DModel
 		relMidPos = m.relMidPos;
 
 		pieces = std::move(m.pieces);
+
+		bposeInstance = m.bposeInstance;
+		m.bposeInstance = nullptr;
 		return *this;
 	}
 
@@ -298,6 +303,12 @@ public:
 	float3 mins;
 	float3 maxs;
 	float3 relMidPos;
+
+	// bind-pose instance of this model which LocalModel::SetModel copies
+	// (rather than rebuilding the piece tree, its matrices and bounding
+	// volume for every new unit or feature); created on first use by the
+	// simulation thread, owned by the model and freed with its pieces
+	mutable LocalModel* bposeInstance;
 };
 
 
@@ -472,6 +483,7 @@ struct LocalModel
 
 private:
 	LocalModelPiece* CreateLocalModelPieces(const S3DModelPiece* mpParent);
+	void CopyLocalModelPieces(const LocalModel* bposeModel);
 
 	void DrawPieces() const;
 	void DrawPiecesLOD(unsigned int lod) const;
@@ -12,6 +12,7 @@
 #include "System/FileSystem/FileHandler.h"
 #include "System/Sync/HsiehHash.h"
 #include "System/Log/ILog.h"
+#include "System/TimeProfiler.h"
 
 #include "System/Config/ConfigHandler.h"
 
@@ -134,6 +135,18 @@ namespace Shader {
 		return hash;
 	}
 
+	void IShaderObject::AppendSourceKey(std::string& key) const {
+		// NUL-separated, none of the parts can contain one
+		key += IntToString(type, "%x");
+		key += '\0';
+		key += rawDefStrs;
+		key += '\0';
+		key += modDefStrs;
+		key += '\0';
+		key += srcText;
+		key += '\0';
+	}
+
 
 	bool IShaderObject::ReloadFromDisk()
 	{
@@ -480,6 +493,8 @@ namespace Shader {
 	}
 
 	void GLSLProgramObject::Reload(bool reloadFromDisk, bool validate) {
+		SCOPED_TIMER("Misc::Shader::Reload");
+
 		const unsigned int oldProgID = objID;
 		const unsigned int oldSrcHash = curSrcHash;
 
@@ -533,34 +548,54 @@ namespace Shader {
 			}
 		}
 
-		// recompile if not found in cache (id 0)
+		// recompile if not found in either cache (id 0)
 		if (objID == 0) {
-			objID = glCreateProgram();
+			CShaderHandler::ProgramBinaryCache& programBinaryCache = shaderHandler->GetProgramBinaryCache();
+			CShaderHandler::ProgramBinaryCache::SourceHash binarySrcHash = {};
 
-			bool shadersValid = true;
-			for (IShaderObject*& so: shaderObjs) {
-				assert(dynamic_cast<GLSLShaderObject*>(so));
-
-				auto gso = static_cast<GLSLShaderObject*>(so);
-				auto obj = gso->CompileShaderObject();
+			// curSrcHash is too weak to identify binaries persisted across runs
+			if (programBinaryCache.IsEnabled()) {
+				std::string srcKey;
 
-				if (obj->valid) {
-					glAttachShader(objID, obj->id);
-				} else {
-					shadersValid = false;
+				for (const IShaderObject* so: shaderObjs) {
+					so->AppendSourceKey(srcKey);
 				}
+
+				binarySrcHash = CShaderHandler::ProgramBinaryCache::GetSourceHash(srcKey);
 			}
 
-			if (!shadersValid)
-				return;
+			objID = glCreateProgram();
+
+			if (programBinaryCache.Load(objID, binarySrcHash)) {
+				valid = true;
+			} else {
+				bool shadersValid = true;
+				for (IShaderObject*& so: shaderObjs) {
+					assert(dynamic_cast<GLSLShaderObject*>(so));
+
+					auto gso = static_cast<GLSLShaderObject*>(so);
+					auto obj = gso->CompileShaderObject();
+
+					if (obj->valid) {
+						glAttachShader(objID, obj->id);
+					} else {
+						shadersValid = false;
+					}
+				}
 
-			glLinkProgram(objID);
+				if (!shadersValid)
+					return;
 
-			valid = glslIsValid(objID);
-			log += glslGetLog(objID);
+				glLinkProgram(objID);
 
-			if (!IsValid()) {
-				LOG_L(L_WARNING, "[GLSL-PO::%s] program-object name: %s, link-log:\n%s\n", __FUNCTION__, name.c_str(), log.c_str());
+				valid = glslIsValid(objID);
+				log += glslGetLog(objID);
+
+				if (!IsValid()) {
+					LOG_L(L_WARNING, "[GLSL-PO::%s] program-object name: %s, link-log:\n%s\n", __FUNCTION__, name.c_str(), log.c_str());
+				} else {
+					programBinaryCache.Save(objID, binarySrcHash);
+				}
 			}
 		} else {
 			valid = true;
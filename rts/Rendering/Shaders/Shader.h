@@ -46,6 +46,8 @@ namespace Shader {
 		unsigned int GetObjID() const { return objID; }
 		unsigned int GetType() const { return type; }
 		unsigned int GetHash() const;
+		/// appends the stage and everything the object is compiled from to <key>
+		void AppendSourceKey(std::string& key) const;
 
 		const std::string& GetLog() const { return log; }
 
@@ -5,10 +5,40 @@
 #include "Rendering/Shaders/ShaderHandler.h"
 #include "Rendering/Shaders/Shader.h"
 #include "Rendering/GlobalRendering.h"
+#include "Rendering/GlobalRenderingInfo.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
 #include "System/StringUtil.h"
+#include "System/Sync/HsiehHash.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+// bump whenever the layout of cached program files changes
+static constexpr std::uint32_t PROGRAM_BINARY_VERSION = 1;
+// per driver; the oldest binaries are pruned beyond this
+static constexpr size_t MAX_PROGRAM_BINARIES = 1024;
+
+static constexpr char PROGRAM_BINARY_MAGIC[4] = {'S', 'P', 'B', 'C'};
+static constexpr char PROGRAM_BINARY_EXT[] = ".pbc";
+
+// followed by the binary itself
+struct ProgramBinaryHeader {
+	char magic[4];
+	std::uint32_t version;
+	std::uint32_t binaryFormat;
+	std::uint8_t srcHash[sha512::SHA_LEN];
+};
+
+
+CONFIG(bool, UseShaderBinaryCache).defaultValue(true).description("If linked GLSL programs should be stored on disk and reused on the next (re)load, instead of being compiled again.");
 
 
 // not extern'ed, so static
@@ -156,3 +186,180 @@ Shader::IShaderObject* CShaderHandler::CreateShaderObject(const std::string& soN
 
 	return so;
 }
+
+
+
+bool CShaderHandler::ProgramBinaryCache::IsEnabled() {
+	if (enabled != -1)
+		return (enabled == 1);
+
+	enabled = 0;
+
+#if (defined(GL_ARB_get_program_binary) && !defined(HEADLESS))
+	if (!GLEW_ARB_get_program_binary || !configHandler->GetBool("UseShaderBinaryCache"))
+		return false;
+
+	GLint numFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+
+	// some drivers advertise the extension but support no formats
+	if (numFormats <= 0)
+		return false;
+
+	// binaries are only valid for the exact driver that produced them
+	const std::string driverStr =
+		std::string(globalRenderingInfo.glVendor) +
+		std::string(globalRenderingInfo.glRenderer) +
+		std::string(globalRenderingInfo.glVersion);
+
+	driverHash = HsiehHash(driverStr.data(), driverStr.size(), 0);
+	cacheDir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/shaders/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+	enabled = !cacheDir.empty();
+
+	if (enabled == 1)
+		PruneFiles();
+#endif
+
+	return (enabled == 1);
+}
+
+void CShaderHandler::ProgramBinaryCache::PruneFiles() const {
+	const std::string filePrefix = GetFilePrefix();
+	const std::vector<std::string> files = dataDirsAccess.FindFiles(cacheDir, "*");
+
+	std::vector< std::pair<unsigned int, std::string> > driverFiles;
+	driverFiles.reserve(files.size());
+
+	for (const std::string& file: files) {
+		const std::string fileName = FileSystem::GetFilename(file);
+
+		// binaries of other drivers (or older cache versions) can never be loaded again
+		if (fileName.compare(0, filePrefix.size(), filePrefix) != 0 || FileSystem::GetExtension(fileName) != (PROGRAM_BINARY_EXT + 1)) {
+			FileSystem::Remove(file);
+			continue;
+		}
+
+		driverFiles.emplace_back(FileSystem::GetFileModificationTime(file), file);
+	}
+
+	if (driverFiles.size() <= MAX_PROGRAM_BINARIES)
+		return;
+
+	// edited shaders leave their old binaries behind, drop the oldest ones
+	std::sort(driverFiles.begin(), driverFiles.end());
+
+	for (size_t i = 0, n = driverFiles.size() - MAX_PROGRAM_BINARIES; i < n; i++) {
+		FileSystem::Remove(driverFiles[i].second);
+	}
+}
+
+
+CShaderHandler::ProgramBinaryCache::SourceHash CShaderHandler::ProgramBinaryCache::GetSourceHash(const std::string& srcKey) {
+	SourceHash srcHash;
+	sha512::calc_digest(reinterpret_cast<const std::uint8_t*>(srcKey.data()), srcKey.size(), srcHash.data());
+	return srcHash;
+}
+
+std::string CShaderHandler::ProgramBinaryCache::GetFilePrefix() const {
+	return (IntToString(driverHash, "%08x") + "_");
+}
+
+std::string CShaderHandler::ProgramBinaryCache::GetFileName(const SourceHash& srcHash) const {
+	char hashStr[sizeof(std::uint64_t) * 2 + 1];
+
+	// the name only needs to spread files, the header holds the full hash
+	for (size_t i = 0; i < sizeof(std::uint64_t); i++) {
+		snprintf(&hashStr[i * 2], 3, "%02x", srcHash[i]);
+	}
+
+	return (cacheDir + GetFilePrefix() + hashStr + PROGRAM_BINARY_EXT);
+}
+
+bool CShaderHandler::ProgramBinaryCache::Load(unsigned int progID, const SourceHash& srcHash) {
+	if (!IsEnabled())
+		return false;
+
+#if (defined(GL_ARB_get_program_binary) && !defined(HEADLESS))
+	FILE* file = fopen(GetFileName(srcHash).c_str(), "rb");
+
+	if (file == nullptr) {
+		glProgramParameteri(progID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		return false;
+	}
+
+	ProgramBinaryHeader header;
+	std::vector<char> binary;
+
+	fseek(file, 0, SEEK_END);
+	const long fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	bool ok = (fileSize > long(sizeof(header)));
+
+	if (ok) {
+		binary.resize(fileSize - sizeof(header));
+
+		ok &= (fread(&header, sizeof(header), 1, file) == 1);
+		ok &= (fread(binary.data(), binary.size(), 1, file) == 1);
+	}
+
+	fclose(file);
+
+	ok = ok && (std::memcmp(header.magic, PROGRAM_BINARY_MAGIC, sizeof(PROGRAM_BINARY_MAGIC)) == 0);
+	ok = ok && (header.version == PROGRAM_BINARY_VERSION);
+	// file names are truncated hashes, make sure this is really our program
+	ok = ok && (std::memcmp(header.srcHash, srcHash.data(), srcHash.size()) == 0);
+
+	if (ok) {
+		// driver rejects stale binaries (e.g. after an update) with a link-error
+		glProgramBinary(progID, header.binaryFormat, binary.data(), binary.size());
+
+		GLint linked = GL_FALSE;
+		glGetProgramiv(progID, GL_LINK_STATUS, &linked);
+
+		if (linked == GL_TRUE)
+			return true;
+	}
+
+	// miss; caller links from source next, keep the result retrievable for Save
+	glProgramParameteri(progID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	return false;
+#else
+	return false;
+#endif
+}
+
+void CShaderHandler::ProgramBinaryCache::Save(unsigned int progID, const SourceHash& srcHash) {
+	if (!IsEnabled())
+		return;
+
+#if (defined(GL_ARB_get_program_binary) && !defined(HEADLESS))
+	GLint binaryLength = 0;
+	glGetProgramiv(progID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+
+	if (binaryLength <= 0)
+		return;
+
+	GLenum binaryFormat = 0;
+	std::vector<char> binary(binaryLength);
+	glGetProgramBinary(progID, binaryLength, nullptr, &binaryFormat, binary.data());
+
+	const std::string fileName = GetFileName(srcHash);
+	FILE* file = fopen(fileName.c_str(), "wb");
+
+	if (file == nullptr) {
+		LOG_L(L_WARNING, "[SH::%s] failed to open \"%s\" for writing", __func__, fileName.c_str());
+		return;
+	}
+
+	ProgramBinaryHeader header;
+	std::memcpy(header.magic, PROGRAM_BINARY_MAGIC, sizeof(PROGRAM_BINARY_MAGIC));
+	std::memcpy(header.srcHash, srcHash.data(), srcHash.size());
+	header.version = PROGRAM_BINARY_VERSION;
+	header.binaryFormat = binaryFormat;
+
+	fwrite(&header, sizeof(header), 1, file);
+	fwrite(binary.data(), binary.size(), 1, file);
+	fclose(file);
+#endif
+}
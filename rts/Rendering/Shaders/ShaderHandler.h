@@ -3,10 +3,13 @@
 #ifndef SPRING_SHADERHANDLER_HDR
 #define SPRING_SHADERHANDLER_HDR
 
+#include <array>
+#include <cstdint>
 #include <string>
 
 #include "Rendering/GL/myGL.h" //GLuint
 #include "System/UnorderedMap.hpp"
+#include "System/Sync/SHA512.hpp"
 
 namespace Shader {
 	struct IProgramObject;
@@ -71,14 +74,55 @@ public:
 		spring::unsynced_map<size_t, GLuint> cache;
 	};
 
+	/**
+	 * Persistent (on-disk) cache of linked GLSL programs, keyed by
+	 * source-hash and driver-string so that restarts and widgets
+	 * re-creating the same shaders can skip compiling and linking.
+	 * Each file stores the full source-hash, which Load verifies;
+	 * binaries of other drivers are pruned when the cache starts.
+	 * Requires GL_ARB_get_program_binary, otherwise a no-op.
+	 */
+	struct ProgramBinaryCache {
+	public:
+		typedef std::array<std::uint8_t, sha512::SHA_LEN> SourceHash;
+
+		ProgramBinaryCache(): driverHash(0), enabled(-1) {}
+
+		bool IsEnabled();
+
+		/// <srcKey> is everything the program is built from, stages included
+		static SourceHash GetSourceHash(const std::string& srcKey);
+
+		/// true if <progID> was linked from a cached binary; on a miss it
+		/// is flagged retrievable so Save can be called after linking it
+		bool Load(unsigned int progID, const SourceHash& srcHash);
+		void Save(unsigned int progID, const SourceHash& srcHash);
+
+	private:
+		std::string GetFileName(const SourceHash& srcHash) const;
+		std::string GetFilePrefix() const;
+
+		void PruneFiles() const;
+
+	private:
+		std::string cacheDir;
+
+		unsigned int driverHash;
+		int enabled;
+	};
+
 	const ShaderCache& GetShaderCache() const { return shaderCache; }
 	      ShaderCache& GetShaderCache()       { return shaderCache; }
 
+	ProgramBinaryCache& GetProgramBinaryCache() { return programBinaryCache; }
+
 private:
 	// all created programs, by name
 	ProgramTable programObjects;
 	// all (re)loaded program ID's, by hash
 	ShaderCache shaderCache;
+	// linked program binaries, by hash and driver
+	ProgramBinaryCache programBinaryCache;
 };
 
 #define shaderHandler (CShaderHandler::GetInstance(1))
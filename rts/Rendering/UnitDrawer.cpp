@@ -8,6 +8,7 @@
 #include "Game/GameHelper.h"
 #include "Game/GameSetup.h"
 #include "Game/GlobalUnsynced.h"
+#include "Game/SelectedUnitsHandler.h"
 #include "Game/Players/Player.h"
 #include "Game/UI/MiniMap.h"
 #include "Map/BaseGroundDrawer.h"
@@ -32,12 +33,14 @@
 #include "Rendering/Models/ModelRenderContainer.h"
 
 #include "Sim/Features/Feature.h"
+#include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/LosHandler.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Projectiles/ExplosionGenerator.h"
 #include "Sim/Units/BuildInfo.h"
 #include "Sim/Units/UnitDef.h"
 #include "Sim/Units/UnitDefHandler.h"
+#include "Sim/Units/UnitHandler.h"
 #include "Sim/Units/Unit.h"
 
 #include "System/Config/ConfigHandler.h"
@@ -255,6 +258,11 @@ CUnitDrawer::CUnitDrawer(): CEventClient("[CUnitDrawer]", 271828, false)
 	deadGhostBuildings.resize(teamHandler->ActiveAllyTeams());
 	liveGhostBuildings.resize(teamHandler->ActiveAllyTeams());
 
+	// no valid ally-team, the first draw writes every quad
+	miniMapIconState.frameNum = -1;
+	miniMapIconState.allyTeam = -1;
+	miniMapIconState.selectionChangeCount = 0;
+
 	// LH must be initialized before drawer-state is initialized
 	lightHandler.Init(2U, configHandler->GetInt("MaxDynamicModelLights"));
 
@@ -1671,28 +1679,29 @@ inline float GetUnitIconScale(const CUnit* unit) {
 }
 
 
-void CUnitDrawer::DrawUnitMiniMapIcon(const CUnit* unit, CVertexArray* va) const {
+bool CUnitDrawer::GetUnitMiniMapIconRect(const CUnit* unit, float4& iconRect, const unsigned char*& iconColor) const {
 	if (unit->noMinimap)
-		return;
+		return false;
 	if (unit->myIcon == nullptr)
-		return;
+		return false;
 	if (unit->IsInVoid())
-		return;
+		return false;
+
+	static const unsigned char defaultColor[4] = {255, 255, 255, 255};
 
-	const unsigned char defaultColor[4] = {255, 255, 255, 255};
-	const unsigned char* color = &defaultColor[0];
+	iconColor = &defaultColor[0];
 
 	if (!unit->isSelected) {
 		if (minimap->UseSimpleColors()) {
 			if (unit->team == gu->myTeam) {
-				color = minimap->GetMyTeamIconColor();
+				iconColor = minimap->GetMyTeamIconColor();
 			} else if (teamHandler->Ally(gu->myAllyTeam, unit->allyteam)) {
-				color = minimap->GetAllyTeamIconColor();
+				iconColor = minimap->GetAllyTeamIconColor();
 			} else {
-				color = minimap->GetEnemyTeamIconColor();
+				iconColor = minimap->GetEnemyTeamIconColor();
 			}
 		} else {
-			color = teamHandler->Team(unit->team)->color;
+			iconColor = teamHandler->Team(unit->team)->color;
 		}
 	}
 
@@ -1704,41 +1713,245 @@ void CUnitDrawer::DrawUnitMiniMapIcon(const CUnit* unit, CVertexArray* va) const
 	const float iconSizeX = (iconScale * minimap->GetUnitSizeX());
 	const float iconSizeY = (iconScale * minimap->GetUnitSizeY());
 
-	const float x0 = iconPos.x - iconSizeX;
-	const float x1 = iconPos.x + iconSizeX;
-	const float y0 = iconPos.z - iconSizeY;
-	const float y1 = iconPos.z + iconSizeY;
+	iconRect.x = iconPos.x - iconSizeX;
+	iconRect.y = iconPos.z - iconSizeY;
+	iconRect.z = iconPos.x + iconSizeX;
+	iconRect.w = iconPos.z + iconSizeY;
+	return true;
+}
+
+void CUnitDrawer::DrawUnitMiniMapIcon(const CUnit* unit, CVertexArray* va) const {
+	float4 iconRect;
+	const unsigned char* iconColor = nullptr;
+
+	if (!GetUnitMiniMapIconRect(unit, iconRect, iconColor))
+		return;
 
-	unit->myIcon->DrawArray(va, x0, y0, x1, y1, color);
+	unit->myIcon->DrawArray(va, iconRect.x, iconRect.y, iconRect.z, iconRect.w, iconColor);
 }
 
 // TODO:
 //   UnitDrawer::DrawIcon was half-duplicate of MiniMap::DrawUnit&co
 //   the latter has been replaced by this, do the same for the former
 //   (mini-map icons and real-map radar icons are the same anyway)
-void CUnitDrawer::DrawUnitMiniMapIcons() const {
-	CVertexArray* va = GetVertexArray();
+void CUnitDrawer::DrawUnitMiniMapIcons() {
+	// quads are persistent, only those of changed units are rewritten
+	UpdateMiniMapIconQuads();
+
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
 
-	for (auto iconIt = unitsByIcon.cbegin(); iconIt != unitsByIcon.cend(); ++iconIt) {
+	for (auto iconIt = miniMapIconQuads.cbegin(); iconIt != miniMapIconQuads.cend(); ++iconIt) {
 		const icon::CIconData* icon = iconIt->first;
-		const std::vector<const CUnit*>& units = iconIt->second;
+		const std::vector<VA_TYPE_2dTC>& quads = iconIt->second;
 
 		if (icon == nullptr)
 			continue;
-		if (units.empty())
+		if (quads.empty())
 			continue;
 
-		va->Initialize();
-		va->EnlargeArrays(units.size() * 4, 0, VA_SIZE_2DTC);
 		icon->BindTexture();
 
-		for (const CUnit* unit: units) {
-			assert(unit->myIcon == icon);
-			DrawUnitMiniMapIcon(unit, va);
+		glVertexPointer(2, GL_FLOAT, sizeof(VA_TYPE_2dTC), &quads[0].x);
+		glTexCoordPointer(2, GL_FLOAT, sizeof(VA_TYPE_2dTC), &quads[0].s);
+		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(VA_TYPE_2dTC), &quads[0].c);
+		glDrawArrays(GL_QUADS, 0, quads.size());
+	}
+
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glDisableClientState(GL_COLOR_ARRAY);
+}
+
+void CUnitDrawer::MarkUnitMiniMapIcon(const CUnit* unit) {
+	MarkUnitMiniMapIcon(unit->id);
+}
+
+void CUnitDrawer::MarkUnitMiniMapIcon(int unitID) {
+	if (unitID >= dirtyMiniMapIconFlags.size())
+		dirtyMiniMapIconFlags.resize(unitID + 1, false);
+
+	if (dirtyMiniMapIconFlags[unitID])
+		return;
+
+	dirtyMiniMapIconFlags[unitID] = true;
+	dirtyMiniMapIcons.push_back(unitID);
+}
+
+void CUnitDrawer::UpdateUnitMiniMapIconQuad(const CUnit* unit) {
+	const auto groupIt = unitsByIcon.find(unit->myIcon);
+
+	if (groupIt == unitsByIcon.end())
+		return;
+
+	// the unit may have died (and its id been reused) since it was marked
+	const std::vector<const CUnit*>& units = groupIt->second;
+	const unsigned int unitIdx = (unit->id < miniMapIconIndices.size())? miniMapIconIndices[unit->id]: -1u;
+
+	if (unitIdx >= units.size() || units[unitIdx] != unit)
+		return;
+
+	VA_TYPE_2dTC* quad = &miniMapIconQuads[unit->myIcon][unitIdx * 4];
+
+	float4 iconRect;
+	const unsigned char* iconColor = nullptr;
+
+	if (!GetUnitMiniMapIconRect(unit, iconRect, iconColor)) {
+		// zero area, rasterizes nothing
+		std::fill(quad, quad + 4, VA_TYPE_2dTC());
+		return;
+	}
+
+	const SColor color(iconColor);
+
+	quad[0] = {iconRect.x, iconRect.y, 0.0f, 0.0f, color};
+	quad[1] = {iconRect.z, iconRect.y, 1.0f, 0.0f, color};
+	quad[2] = {iconRect.z, iconRect.w, 1.0f, 1.0f, color};
+	quad[3] = {iconRect.x, iconRect.w, 0.0f, 1.0f, color};
+
+	if (unit->isSelected)
+		selectedMiniMapIcons.push_back(unit->id);
+
+	// no event reports these moving, refresh them every frame
+	if (unit->GetTransporter() != nullptr || (!gu->spectatingFullView && unit->GetErrorVector(gu->myAllyTeam) != ZeroVector))
+		volatileMiniMapIcons.push_back(unit->id);
+}
+
+void CUnitDrawer::UpdateMiniMapIconQuads() {
+	MiniMapIconState& s = miniMapIconState;
+
+	bool updateAll = false;
+
+	updateAll |= (s.allyTeam != gu->myAllyTeam);
+	updateAll |= (s.unitSize != float2(minimap->GetUnitSizeX(), minimap->GetUnitSizeY()));
+	updateAll |= (s.fullView != gu->spectatingFullView);
+	updateAll |= (s.useIcons != minimap->UseUnitIcons());
+	updateAll |= (s.simpleColors != minimap->UseSimpleColors());
+
+	s.allyTeam = gu->myAllyTeam;
+	s.unitSize = float2(minimap->GetUnitSizeX(), minimap->GetUnitSizeY());
+	s.fullView = gu->spectatingFullView;
+	s.useIcons = minimap->UseUnitIcons();
+	s.simpleColors = minimap->UseSimpleColors();
+
+	if (updateAll) {
+		for (auto iconIt = unitsByIcon.cbegin(); iconIt != unitsByIcon.cend(); ++iconIt) {
+			for (const CUnit* unit: iconIt->second) {
+				MarkUnitMiniMapIcon(unit);
+			}
 		}
+	}
 
-		va->DrawArray2dTC(GL_QUADS);
+	// team colors can be changed by Lua at any time, without an event
+	miniMapTeamColors.resize(teamHandler->ActiveTeams());
+
+	for (int teamNum = 0; teamNum < teamHandler->ActiveTeams(); teamNum++) {
+		const SColor teamColor(teamHandler->Team(teamNum)->color);
+
+		if (teamColor == miniMapTeamColors[teamNum])
+			continue;
+
+		miniMapTeamColors[teamNum] = teamColor;
+
+		for (auto iconIt = unitsByIcon.cbegin(); iconIt != unitsByIcon.cend(); ++iconIt) {
+			for (const CUnit* unit: iconIt->second) {
+				if (unit->team == teamNum)
+					MarkUnitMiniMapIcon(unit);
+			}
+		}
+	}
+
+	// selected units are drawn white, update those that left or joined
+	if (s.selectionChangeCount != selectedUnitsHandler.selectionChangeCount) {
+		s.selectionChangeCount = selectedUnitsHandler.selectionChangeCount;
+
+		for (const int unitID: selectedMiniMapIcons) {
+			MarkUnitMiniMapIcon(unitID);
+		}
+		for (const int unitID: selectedUnitsHandler.selectedUnits) {
+			MarkUnitMiniMapIcon(unitID);
+		}
+	}
+
+	if (s.frameNum != gs->frameNum) {
+		s.frameNum = gs->frameNum;
+
+		for (const int unitID: volatileMiniMapIcons) {
+			MarkUnitMiniMapIcon(unitID);
+		}
+
+		// anything else without an event (e.g. Lua changing a unit's radius or
+		// void-state) is picked up by sweeping over all icons once per slow-update
+		for (auto iconIt = unitsByIcon.cbegin(); iconIt != unitsByIcon.cend(); ++iconIt) {
+			const std::vector<const CUnit*>& units = iconIt->second;
+
+			for (size_t n = gs->frameNum % UNIT_SLOWUPDATE_RATE; n < units.size(); n += UNIT_SLOWUPDATE_RATE) {
+				MarkUnitMiniMapIcon(units[n]);
+			}
+		}
+	}
+
+	if (dirtyMiniMapIcons.empty())
+		return;
+
+	// both lists are refilled by UpdateUnitMiniMapIconQuad for every rewritten
+	// quad; dead units are marked as well, which drops them here
+	const auto IsDirty = [&](int unitID) { return (dirtyMiniMapIconFlags[unitID]); };
+
+	selectedMiniMapIcons.erase(std::remove_if(selectedMiniMapIcons.begin(), selectedMiniMapIcons.end(), IsDirty), selectedMiniMapIcons.end());
+	volatileMiniMapIcons.erase(std::remove_if(volatileMiniMapIcons.begin(), volatileMiniMapIcons.end(), IsDirty), volatileMiniMapIcons.end());
+
+	for (const int unitID: dirtyMiniMapIcons) {
+		const CUnit* unit = unitHandler->GetUnit(unitID);
+
+		dirtyMiniMapIconFlags[unitID] = false;
+
+		if (unit == nullptr)
+			continue;
+
+		UpdateUnitMiniMapIconQuad(unit);
 	}
+
+	dirtyMiniMapIcons.clear();
+}
+
+
+void CUnitDrawer::AddUnitMiniMapIcon(icon::CIconData* icon, const CUnit* unit) {
+	std::vector<const CUnit*>& units = unitsByIcon[icon];
+	std::vector<VA_TYPE_2dTC>& quads = miniMapIconQuads[icon];
+
+	if (unit->id >= miniMapIconIndices.size())
+		miniMapIconIndices.resize(unit->id + 1, -1u);
+
+	miniMapIconIndices[unit->id] = units.size();
+
+	units.push_back(unit);
+	quads.resize(units.size() * 4);
+
+	MarkUnitMiniMapIcon(unit);
+}
+
+void CUnitDrawer::DelUnitMiniMapIcon(icon::CIconData* icon, const CUnit* unit) {
+	std::vector<const CUnit*>& units = unitsByIcon[icon];
+	std::vector<VA_TYPE_2dTC>& quads = miniMapIconQuads[icon];
+
+	const auto unitIt = std::find(units.begin(), units.end(), unit);
+
+	if (unitIt == units.end())
+		return;
+
+	// same swap-and-pop as spring::VectorErase, the last unit's quad moves along
+	const size_t unitIdx = unitIt - units.begin();
+	const size_t lastIdx = units.size() - 1;
+
+	units[unitIdx] = units[lastIdx];
+	std::copy(quads.begin() + lastIdx * 4, quads.begin() + lastIdx * 4 + 4, quads.begin() + unitIdx * 4);
+
+	miniMapIconIndices[units[unitIdx]->id] = unitIdx;
+
+	units.pop_back();
+	quads.resize(units.size() * 4);
 }
 
 void CUnitDrawer::UpdateUnitMiniMapIcon(const CUnit* unit, bool forced, bool killed) {
@@ -1751,15 +1964,18 @@ void CUnitDrawer::UpdateUnitMiniMapIcon(const CUnit* unit, bool forced, bool kil
 
 	if (!killed) {
 		if ((oldIcon != newIcon) || forced) {
-			spring::VectorErase(unitsByIcon[oldIcon], unit);
-			unitsByIcon[newIcon].push_back(unit);
+			DelUnitMiniMapIcon(oldIcon, unit);
+			AddUnitMiniMapIcon(newIcon, unit);
+		} else {
+			// same icon, but its LOS-dependent size or position might differ
+			MarkUnitMiniMapIcon(unit);
 		}
 
 		u->myIcon = newIcon;
 		return;
 	}
 
-	spring::VectorErase(unitsByIcon[oldIcon], unit);
+	DelUnitMiniMapIcon(oldIcon, unit);
 }
 
 
@@ -1897,6 +2113,9 @@ void CUnitDrawer::PlayerChanged(int playerNum) {
 	for (auto iconIt = unitsByIcon.begin(); iconIt != unitsByIcon.end(); ++iconIt) {
 		(iconIt->second).clear();
 	}
+	for (auto iconIt = miniMapIconQuads.begin(); iconIt != miniMapIconQuads.end(); ++iconIt) {
+		(iconIt->second).clear();
+	}
 
 	for (CUnit* unit: unsortedUnits) {
 		// force an erase (no-op) followed by an insert
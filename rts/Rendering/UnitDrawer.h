@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "Rendering/GL/LightHandler.h"
+#include "Rendering/GL/VertexArray.h"
 #include "Rendering/Models/3DModel.h"
 #include "Rendering/UnitDrawerState.hpp"
 #include "System/EventClient.h"
@@ -20,7 +21,6 @@ struct S3DModel;
 class IModelRenderContainer;
 class CSolidObject;
 class CUnit;
-class CVertexArray;
 
 struct Command;
 struct BuildInfo;
@@ -66,6 +66,7 @@ public:
 			eventName == "UnitCloaked"            || eventName == "UnitDecloaked"        ||
 			eventName == "UnitEnteredRadar"       || eventName == "UnitEnteredLos"       ||
 			eventName == "UnitLeftRadar"          || eventName == "UnitLeftLos"          ||
+			eventName == "UnitMoved"              || eventName == "UnitGiven"            ||
 			eventName == "PlayerChanged"          || eventName == "SunChanged";
 	}
 	bool GetFullRead() const { return true; }
@@ -82,6 +83,9 @@ public:
 	void UnitCloaked(const CUnit* unit);
 	void UnitDecloaked(const CUnit* unit);
 
+	void UnitMoved(const CUnit* unit) { MarkUnitMiniMapIcon(unit); }
+	void UnitGiven(const CUnit* unit, int oldTeam, int newTeam) { MarkUnitMiniMapIcon(unit); }
+
 	void PlayerChanged(int playerNum);
 	void SunChanged();
 
@@ -136,7 +140,7 @@ public:
 	bool ShowUnitBuildSquare(const BuildInfo& buildInfo);
 	bool ShowUnitBuildSquare(const BuildInfo& buildInfo, const std::vector<Command>& commands);
 
-	void DrawUnitMiniMapIcons() const;
+	void DrawUnitMiniMapIcons();
 
 
 	const std::vector<CUnit*>& GetUnsortedUnits() const { return unsortedUnits; }
@@ -204,8 +208,19 @@ private:
 public:
 	void DrawUnitIcons();
 	void DrawUnitMiniMapIcon(const CUnit* unit, CVertexArray* va) const;
+
+	/// queues the unit's minimap icon for an update, for changes no event reports
+	void MarkUnitMiniMapIcon(const CUnit* unit);
 private:
+	void MarkUnitMiniMapIcon(int unitID);
+
+	bool GetUnitMiniMapIconRect(const CUnit* unit, float4& iconRect, const unsigned char*& iconColor) const;
+
 	void UpdateUnitMiniMapIcon(const CUnit* unit, bool forced, bool killed);
+	void AddUnitMiniMapIcon(icon::CIconData* icon, const CUnit* unit);
+	void DelUnitMiniMapIcon(icon::CIconData* icon, const CUnit* unit);
+	void UpdateUnitMiniMapIconQuad(const CUnit* unit);
+	void UpdateMiniMapIconQuads();
 	void UpdateUnitIconState(CUnit* unit);
 
 	static void DrawIcon(CUnit* unit, bool asRadarBlip);
@@ -284,6 +299,35 @@ private:
 
 	spring::unsynced_map<icon::CIconData*, std::vector<const CUnit*> > unitsByIcon;
 
+	/// everything the minimap icon quads depend on besides unit state
+	struct MiniMapIconState {
+		int frameNum;
+		int allyTeam;
+		unsigned int selectionChangeCount;
+		float2 unitSize;
+		bool fullView;
+		bool useIcons;
+		bool simpleColors;
+	};
+
+	/// persistent minimap icon quads, four vertices per unit in unitsByIcon order;
+	/// hidden units keep their slot with a degenerate quad
+	spring::unsynced_map<icon::CIconData*, std::vector<VA_TYPE_2dTC> > miniMapIconQuads;
+	/// index of every unit within its unitsByIcon group, by unit id
+	std::vector<unsigned int> miniMapIconIndices;
+
+	/// units whose quads are rewritten before the next minimap draw
+	std::vector<int> dirtyMiniMapIcons;
+	std::vector<bool> dirtyMiniMapIconFlags;
+	/// units whose icon moves every frame without an event (radar error, transported)
+	std::vector<int> volatileMiniMapIcons;
+	/// units that were drawn as selected
+	std::vector<int> selectedMiniMapIcons;
+	/// team colors the quads were written with
+	std::vector<SColor> miniMapTeamColors;
+
+	MiniMapIconState miniMapIconState;
+
 	// [0] := fallback shader-less rendering path
 	// [1] := default shader-driven rendering path
 	// [2] := currently selected state
@@ -27,6 +27,8 @@
 #include "System/creg/DefTypes.h"
 #include "System/Log/ILog.h"
 
+#include <limits>
+
 
 CR_BIND_DERIVED_POOL(CFeature, CSolidObject, , featureMemPool.alloc, featureMemPool.free)
 
@@ -45,6 +47,8 @@ CR_REG_METADATA(CFeature, (
 	CR_MEMBER(lastReclaimFrame),
 	CR_MEMBER(fireTime),
 	CR_MEMBER(smokeTime),
+	CR_MEMBER(sleepFrame),
+	CR_MEMBER(wakeFrame),
 
 	CR_MEMBER(drawQuad),
 	CR_MEMBER(drawFlag),
@@ -89,6 +93,8 @@ CFeature::CFeature()
 , lastReclaimFrame(0)
 , fireTime(0)
 , smokeTime(0)
+, sleepFrame(-1)
+, wakeFrame(-1)
 
 , drawQuad(-2)
 , drawFlag(-1)
@@ -495,6 +501,10 @@ void CFeature::ForcedMove(const float3& newPos)
 
 	// insert into managers
 	quadField->AddFeature(this);
+
+	// a sleeping feature would not notice its new ground until
+	// the next smoke puff or the end of its fire, wake it now
+	featureHandler->SetFeatureUpdateable(this);
 }
 
 
@@ -503,6 +513,8 @@ void CFeature::ForcedSpin(const float3& newDir)
 	// update local direction-vectors
 	CSolidObject::ForcedSpin(newDir);
 	UpdateTransform(pos, true);
+
+	featureHandler->SetFeatureUpdateable(this);
 }
 
 
@@ -607,13 +619,9 @@ bool CFeature::UpdatePosition()
 }
 
 
-bool CFeature::Update()
+int CFeature::Update()
 {
-	bool continueUpdating = UpdatePosition();
-
-	continueUpdating |= (smokeTime != 0);
-	continueUpdating |= (fireTime != 0);
-	continueUpdating |= (def->geoThermal);
+	const bool moved = UpdatePosition();
 
 	if (smokeTime != 0) {
 		if (!((gs->frameNum + id) & 3) && projectileHandler->GetParticleSaturation() < 0.7f) {
@@ -635,8 +643,48 @@ bool CFeature::Update()
 	smokeTime = std::max(smokeTime - 1, 0);
 	fireTime = std::max(fireTime - 1, 0);
 
-	// return true so long as we need to stay in the FH update-queue
-	return continueUpdating;
+	// moving (or about to be deleted), stay awake
+	if (moved || deleteMe)
+		return 0;
+
+	// at rest; the frames in between only count the timers down
+	const int sleepFrames = GetSleepFrames();
+
+	// leaving the update-queue for good, nothing would count down the
+	// remaining smoke frames (which are too few for another puff) anymore
+	if (sleepFrames < 0)
+		smokeTime = 0;
+
+	return sleepFrames;
+}
+
+
+int CFeature::GetSleepFrames() const
+{
+	constexpr int NO_EVENT = std::numeric_limits<int>::max();
+
+	// distance (in frames) to the next Update that does more than tick timers
+	int delta = NO_EVENT;
+
+	if (smokeTime != 0) {
+		const int d = 4 - ((gs->frameNum + id) & 3);
+
+		// next puff, unless smokeTime runs out before it is due
+		if (d <= smokeTime)
+			delta = d;
+	}
+
+	// fireTime reaches 1 exactly <fireTime> frames from now
+	if (fireTime != 0)
+		delta = std::min(delta, fireTime);
+
+	if (def->geoThermal)
+		delta = std::min(delta, 5 - ((gs->frameNum + id % 5) % 5));
+
+	if (delta == NO_EVENT)
+		return -1;
+
+	return (delta - 1);
 }
 
 
@@ -645,8 +693,9 @@ void CFeature::StartFire()
 	if (fireTime != 0 || !def->burnable)
 		return;
 
-	fireTime = 200 + (int)(gsRNG.NextFloat() * GAME_SPEED);
+	// wake up first, catching up on skipped updates must not eat into fireTime
 	featureHandler->SetFeatureUpdateable(this);
+	fireTime = 200 + (int)(gsRNG.NextFloat() * GAME_SPEED);
 
 	myFire = projMemPool.alloc<CFireProjectile>(midPos, UpVector, nullptr, 300, 70, radius * 0.8f, 20.0f);
 }
@@ -3,6 +3,7 @@
 #ifndef _FEATURE_H
 #define _FEATURE_H
 
+#include <algorithm>
 #include <vector>
 #include <list>
 #include <string>
@@ -90,7 +91,11 @@ public:
 	void ForcedMove(const float3& newPos);
 	void ForcedSpin(const float3& newDir);
 
-	bool Update();
+	/**
+	 * @return number of frames the feature may sleep on the FH timer wheel
+	 *   before it needs to be updated again, or -1 if it can leave the queue
+	 */
+	int Update();
 	bool UpdatePosition();
 	bool UpdateVelocity(const float3& dragAccel, const float3& gravAccel, const float3& movMask, const float3& velMask);
 
@@ -102,6 +107,12 @@ public:
 	void StartFire();
 	void EmitGeoSmoke();
 
+	/// catch up on <numFrames> updates skipped while at rest
+	void SkipUpdates(int numFrames) {
+		smokeTime = std::max(smokeTime - numFrames, 0);
+		fireTime = std::max(fireTime - numFrames, 0);
+	}
+
 	void DependentDied(CObject *o);
 	void ChangeTeam(int newTeam);
 
@@ -116,6 +127,8 @@ public:
 private:
 	static int ChunkNumber(float f);
 
+	int GetSleepFrames() const;
+
 public:
 	/**
 	 * This flag is used to stop a potential exploit involving tripping
@@ -140,6 +153,9 @@ public:
 	int fireTime;
 	int smokeTime;
 
+	int sleepFrame; /// frame of the last Update before going to sleep on the FH timer wheel
+	int wakeFrame; /// frame at which the FH wakes this feature up again, -1 if awake
+
 	int drawQuad; /// which drawQuad we are part of (unsynced)
 	int drawFlag; /// one of FD_*_FLAG (unsynced)
 
@@ -13,6 +13,7 @@
 #include "System/creg/STL_Set.h"
 #include "System/EventHandler.h"
 #include "System/TimeProfiler.h"
+#include "System/Log/ILog.h"
 
 /******************************************************************************/
 
@@ -22,7 +23,13 @@ CR_REG_METADATA(CFeatureHandler, (
 	CR_MEMBER(deletedFeatureIDs),
 	CR_MEMBER(activeFeatureIDs),
 	CR_MEMBER(features),
-	CR_MEMBER(updateFeatures)
+	CR_MEMBER(updateFeatures),
+	CR_MEMBER(sleepingFeatures),
+	CR_MEMBER(lastUpdateFrame),
+	CR_IGNORED(numFeatureUpdates),
+	CR_IGNORED(numSkippedUpdates),
+	CR_IGNORED(numFrameFeatureUpdates),
+	CR_IGNORED(numFrameSkippedUpdates)
 ))
 
 /******************************************************************************/
@@ -35,6 +42,7 @@ CFeatureHandler* featureHandler = nullptr;
 CFeatureHandler::CFeatureHandler() {
 	features.resize(MAX_FEATURES, nullptr);
 	activeFeatureIDs.reserve(MAX_FEATURES);
+	sleepingFeatures.resize(FEATURE_SLEEP_WHEEL_SIZE);
 
 	featureMemPool.reserve(128);
 	idPool.Expand(0, features.size());
@@ -178,12 +186,20 @@ void CFeatureHandler::Update()
 
 		deletedFeatureIDs.erase(iter, deletedFeatureIDs.end());
 	}
+
+	numFrameFeatureUpdates = 0;
+	numFrameSkippedUpdates = 0;
+
+	WakeSleepingFeatures();
+
 	{
 		const auto& pred = [this](CFeature* feature) { return (this->UpdateFeature(feature)); };
 		const auto& iter = std::remove_if(updateFeatures.begin(), updateFeatures.end(), pred);
 
 		updateFeatures.erase(iter, updateFeatures.end());
 	}
+
+	lastUpdateFrame = gs->frameNum;
 }
 
 
@@ -224,41 +240,135 @@ bool CFeatureHandler::UpdateFeature(CFeature* feature)
 		return true;
 	}
 
-	if (!feature->Update()) {
+	numFeatureUpdates += 1;
+	numFrameFeatureUpdates += 1;
+
+	const int sleepFrames = feature->Update();
+
+	if (sleepFrames < 0) {
 		// feature is done updating itself, remove from queue
 		feature->inUpdateQue = false;
 		return true;
 	}
 
+	if (sleepFrames > 0) {
+		// nothing to do until a later frame, park on the wheel
+		SleepFeature(feature, sleepFrames);
+		return true;
+	}
+
 	return false;
 }
 
 
+void CFeatureHandler::SleepFeature(CFeature* feature, int sleepFrames)
+{
+	// the wake-up slot must not be the one currently being processed
+	sleepFrames = std::min(sleepFrames, FEATURE_SLEEP_WHEEL_SIZE - 2);
+
+	feature->sleepFrame = gs->frameNum;
+	feature->wakeFrame = gs->frameNum + 1 + sleepFrames;
+
+	sleepingFeatures[feature->wakeFrame % FEATURE_SLEEP_WHEEL_SIZE].push_back(feature);
+}
+
+void CFeatureHandler::WakeFeature(CFeature* feature)
+{
+	assert(feature->wakeFrame > lastUpdateFrame);
+
+	// every frame since going to sleep that the FH already processed was skipped
+	const int skippedFrames = lastUpdateFrame - feature->sleepFrame;
+
+	feature->SkipUpdates(skippedFrames);
+	feature->sleepFrame = -1;
+	feature->wakeFrame = -1;
+
+	numSkippedUpdates += skippedFrames;
+	numFrameSkippedUpdates += skippedFrames;
+	updateFeatures.push_back(feature);
+}
+
+void CFeatureHandler::WakeSleepingFeatures()
+{
+	auto& slot = sleepingFeatures[gs->frameNum % FEATURE_SLEEP_WHEEL_SIZE];
+
+	for (CFeature* feature: slot) {
+		assert(feature->wakeFrame == gs->frameNum);
+		WakeFeature(feature);
+	}
+
+	slot.clear();
+}
+
+
 void CFeatureHandler::SetFeatureUpdateable(CFeature* feature)
 {
 	if (feature->inUpdateQue) {
-		assert(std::find(updateFeatures.begin(), updateFeatures.end(), feature) != updateFeatures.end());
+		if (feature->wakeFrame < 0) {
+			assert(std::find(updateFeatures.begin(), updateFeatures.end(), feature) != updateFeatures.end());
+			return;
+		}
+
+		// sleeping on the wheel, take it off early
+		auto& slot = sleepingFeatures[feature->wakeFrame % FEATURE_SLEEP_WHEEL_SIZE];
+		auto iter = std::find(slot.begin(), slot.end(), feature);
+
+		assert(iter != slot.end());
+		*iter = slot.back();
+		slot.pop_back();
+
+		WakeFeature(feature);
 		return;
 	}
 
-	// always true
-	feature->inUpdateQue = spring::VectorInsertUnique(updateFeatures, feature);
+	// inUpdateQue guarantees uniqueness, no need for a linear search
+	assert(std::find(updateFeatures.begin(), updateFeatures.end(), feature) == updateFeatures.end());
+
+	updateFeatures.push_back(feature);
+	feature->inUpdateQue = true;
 }
 
 
 void CFeatureHandler::TerrainChanged(int x1, int y1, int x2, int y2)
 {
-	const float3 mins(x1 * SQUARE_SIZE, 0, y1 * SQUARE_SIZE);
-	const float3 maxs(x2 * SQUARE_SIZE, 0, y2 * SQUARE_SIZE);
-
+	// the coordinates are heightmap vertices, the squares around them
+	// (and hence the ground height at any feature position inside them)
+	// changed as well
+	const float3 mins((x1 - 1) * SQUARE_SIZE, 0, (y1 - 1) * SQUARE_SIZE);
+	const float3 maxs((x2 + 1) * SQUARE_SIZE, 0, (y2 + 1) * SQUARE_SIZE);
+
+	// features only sample the ground at their position, so an exact
+	// position query over the rectangle finds all that might need to
+	// fall or rise; quads are much larger than most changed areas
 	QuadFieldQuery qfQuery;
-	quadField->GetQuadsRectangle(qfQuery, mins, maxs);
+	quadField->GetFeaturesExact(qfQuery, mins, maxs);
 
-	for (const int qi: *qfQuery.quads) {
-		for (CFeature* f: quadField->GetQuad(qi).features) {
-			// put this feature back in the update-queue
-			SetFeatureUpdateable(f);
-		}
+	for (CFeature* f: *qfQuery.features) {
+		// put this feature back in the update-queue
+		SetFeatureUpdateable(f);
 	}
 }
 
+
+void CFeatureHandler::PrintDebugInfo() const
+{
+	size_t numSleeping = 0;
+
+	for (const auto& slot: sleepingFeatures) {
+		numSleeping += slot.size();
+	}
+
+	LOG("[FeatureHandler] features: active=%u queued=%u sleeping=%u",
+		(unsigned int) activeFeatureIDs.size(),
+		(unsigned int) updateFeatures.size(),
+		(unsigned int) numSleeping
+	);
+	LOG("[FeatureHandler] updates (last frame): executed=%u skipped=%u",
+		numFrameFeatureUpdates,
+		numFrameSkippedUpdates
+	);
+	LOG("[FeatureHandler] updates (total): executed=%lu skipped=%lu",
+		(unsigned long) numFeatureUpdates,
+		(unsigned long) numSkippedUpdates
+	);
+}
@@ -3,6 +3,7 @@
 #ifndef _FEATURE_HANDLER_H
 #define _FEATURE_HANDLER_H
 
+#include <cstdint>
 #include <deque>
 #include <vector>
 
@@ -37,6 +38,12 @@ struct FeatureLoadParams {
 };
 
 class LuaParser;
+
+// features at rest only need an Update when a puff of smoke, the end of
+// a fire or a geothermal emission is due; until then they sleep on this
+// many wheel-slots (one per frame, indexed by wake-up frame modulo size)
+static constexpr int FEATURE_SLEEP_WHEEL_SIZE = 256;
+
 class CFeatureHandler : public spring::noncopyable
 {
 	CR_DECLARE_STRUCT(CFeatureHandler)
@@ -61,6 +68,8 @@ public:
 	void SetFeatureUpdateable(CFeature* feature);
 	void TerrainChanged(int x1, int y1, int x2, int y2);
 
+	void PrintDebugInfo() const;
+
 	const spring::unordered_set<int>& GetActiveFeatureIDs() const { return activeFeatureIDs; }
 
 private:
@@ -77,6 +86,10 @@ private:
 
 	void InsertActiveFeature(CFeature* feature);
 
+	void SleepFeature(CFeature* feature, int sleepFrames);
+	void WakeFeature(CFeature* feature);
+	void WakeSleepingFeatures();
+
 private:
 	SimObjectIDPool idPool;
 
@@ -84,6 +97,18 @@ private:
 	std::vector<int> deletedFeatureIDs;
 	std::vector<CFeature*> features;
 	std::vector<CFeature*> updateFeatures;
+	std::vector< std::vector<CFeature*> > sleepingFeatures;
+
+	// last frame in which Update was called
+	int lastUpdateFrame = -1;
+
+	// number of UpdateFeature calls vs. updates skipped by sleeping features,
+	// in total and during the last frame (skips count when a feature wakes)
+	uint64_t numFeatureUpdates = 0;
+	uint64_t numSkippedUpdates = 0;
+
+	unsigned int numFrameFeatureUpdates = 0;
+	unsigned int numFrameSkippedUpdates = 0;
 };
 
 extern CFeatureHandler* featureHandler;
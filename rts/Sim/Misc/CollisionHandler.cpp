@@ -3,6 +3,7 @@
 
 #include "CollisionHandler.h"
 #include "CollisionVolume.h"
+#include "CollisionVolumeBatch.h"
 #include "Map/ReadMap.h" // mapDims
 #include "Rendering/Models/3DModel.h"
 #include "Sim/Misc/GroundBlockingObjectMap.h"
@@ -260,41 +261,62 @@ bool CCollisionHandler::IntersectPiecesHelper(
 	const float3& p1,
 	CollisionQuery* cq
 ) {
-	CMatrix44f volMat;
+	CollisionVolumeBatch batch;
+	CollisionQuery cqs[CollisionVolumeBatch::NUM_LANES];
+
+	const LocalModelPiece* lmps[CollisionVolumeBatch::NUM_LANES];
+	bool hits[CollisionVolumeBatch::NUM_LANES];
 
 	float minDistSq = std::numeric_limits<float>::max();
 	float curDistSq = minDistSq;
 
-	for (unsigned int n = 0; n < o->localModel.pieces.size(); n++) {
-		const LocalModelPiece* lmp = o->localModel.GetPiece(n);
-		const CollisionVolume* lmpVol = lmp->GetCollisionVolume();
+	for (unsigned int n = 0, numPieces = o->localModel.pieces.size(); n < numPieces; ) {
+		batch.Clear();
 
-		if (!lmp->scriptSetVisible || lmpVol->IgnoreHits())
-			continue;
+		// gather the next set of hittable pieces; all are tested against the ray at once
+		for (; n < numPieces && !batch.Full(); n++) {
+			const LocalModelPiece* lmp = o->localModel.GetPiece(n);
+			const CollisionVolume* lmpVol = lmp->GetCollisionVolume();
 
-		volMat = m * lmp->GetModelSpaceMatrix();
-		volMat.Translate(lmpVol->GetOffsets());
+			if (!lmp->scriptSetVisible || lmpVol->IgnoreHits())
+				continue;
 
-		CollisionQuery cqn;
-		if (!CCollisionHandler::Intersect(lmpVol, volMat, p0, p1, &cqn))
-			continue;
+			CMatrix44f volMat = m * lmp->GetModelSpaceMatrix();
+			volMat.Translate(lmpVol->GetOffsets());
 
-		// skip if neither an ingress nor an egress hit
-		if (!cqn.AnyHit())
-			continue;
+			lmps[batch.Size()] = lmp;
+			batch.Add(volMat, lmpVol->GetHScales(), lmpVol->GetHIScales(), lmpVol->GetVolumeType(), lmpVol);
+		}
 
-		// save the closest intersection (others are not needed)
-		if ((curDistSq = (cqn.GetHitPos()).SqDistance(p0)) >= minDistSq)
+		if (batch.Empty())
 			continue;
 
-		minDistSq = curDistSq;
+		std::fill(cqs, cqs + batch.Size(), CollisionQuery());
+		CCollisionHandler::IntersectBatch(batch, p0, p1, cqs, hits);
+
+		for (size_t i = 0; i < batch.Size(); i++) {
+			const CollisionQuery& cqn = cqs[i];
+
+			if (!hits[i])
+				continue;
+
+			// skip if neither an ingress nor an egress hit
+			if (!cqn.AnyHit())
+				continue;
 
-		// return early if caller only wants to know a collision exists
-		if (cq == nullptr)
-			return true;
+			// save the closest intersection (others are not needed)
+			if ((curDistSq = (cqn.GetHitPos()).SqDistance(p0)) >= minDistSq)
+				continue;
 
-		*cq = cqn;
-		cq->SetHitPiece(lmp);
+			minDistSq = curDistSq;
+
+			// return early if caller only wants to know a collision exists
+			if (cq == nullptr)
+				return true;
+
+			*cq = cqn;
+			cq->SetHitPiece(lmps[i]);
+		}
 	}
 
 	// true iff at least one piece was intersected
@@ -395,100 +417,52 @@ bool CCollisionHandler::Intersect(const CollisionVolume* v, const CMatrix44f& m,
 	return intersect;
 }
 
-bool CCollisionHandler::IntersectEllipsoid(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* q)
+void CCollisionHandler::IntersectBatch(CollisionVolumeBatch& batch, const float3& p0, const float3& p1, CollisionQuery* cqs, bool* hits)
 {
-	// transform the volume-space points into (unit) sphere-space (requires fewer
-	// float-ops than solving the surface equation for arbitrary ellipsoid volumes)
-	const float3 pii0 = pi0 * v->GetHIScales();
-	const float3 pii1 = pi1 * v->GetHIScales();
-	const float rSq = 1.0f;
+	numContTests += batch.Size();
 
-	if (pii0.dot(pii0) <= rSq) {
-		if (q != nullptr) {
-			// terminate early in the special case
-			// that ray-segment originated *in* <v>
-			// (these points are NOT transformed!)
-			q->b0 = CQ_POINT_IN_VOL; q->p0 = ZeroVector;
-			q->b1 = CQ_POINT_IN_VOL; q->p1 = ZeroVector;
-		}
-		return true;
-	}
+	std::fill(hits, hits + batch.Size(), false);
 
-	// get the ray direction in unit-sphere space
-	const float3 dir = (pii1 - pii0).SafeNormalize();
-
-	// solves [ x^2 + y^2 + z^2 == r^2 ] for t; closest
-	// point on ray is p(t) = p0 + (p1-p0)*t = p0 + d*t
-	// (A represents dir.dot(dir), which equals 1 since
-	// the ray direction is already normalized)
-	// const float A = (pii1 - pii0).dot(pii1 - pii0);
-	// const float B = 2.0f * pii0.dot(pii1 - pii0);
-	const float A = 1.0f;
-	const float B = 2.0f * pii0.dot(dir);
-	const float C = pii0.dot(pii0) - rSq;
-	const float D = (B * B) - (4.0f * A * C);
-
-	if (D < -COLLISION_VOLUME_EPS) {
-		return false;
-	} else {
-		// get the length of the ray segment in volume-space
-		const float segLenSq = (pi1 - pi0).SqLength();
-
-		if (D < COLLISION_VOLUME_EPS) {
-			// one solution for t
-			const float t0 = -B * 0.5f;
-			// const float t0 = -B / (2.0f * A);
-			// get the intersection point in sphere-space
-			const float3 pTmp = pii0 + (dir * t0);
-			// get the intersection point in volume-space
-			const float3 p0 = pTmp * v->GetHScales();
-			// get the distance from the start of the segment
-			// to the intersection point in volume-space
-			const float dSq0 = (p0 - pi0).SqLength();
-			// if the intersection point is closer to p0 than
-			// the end of the ray segment, the hit is valid
-			const int b0 = (t0 > 0.0f && dSq0 <= segLenSq) * CQ_POINT_ON_RAY;
-
-			if (q != nullptr) {
-				q->b0 = b0; q->b1 = CQ_POINT_NO_INT;
-				q->t0 = t0; q->t1 = 0.0f;
-				q->p0 = p0; q->p1 = ZeroVector;
-			}
+	// transform the ray into each volume's space and reject bounding-box misses
+	if (batch.TransformRay(p0, p1) == 0)
+		return;
 
-			return (b0 == CQ_POINT_ON_RAY);
-		} else {
-			// two solutions for t
-			const float rD = fastmath::apxsqrt(D);
-			const float t0 = (-B - rD) * 0.5f;
-			const float t1 = (-B + rD) * 0.5f;
-			// const float t0 = (-B + rD) / (2.0f * A);
-			// const float t1 = (-B - rD) / (2.0f * A);
-			// get the intersection points in sphere-space
-			const float3 pTmp0 = pii0 + (dir * t0);
-			const float3 pTmp1 = pii0 + (dir * t1);
-			// get the intersection points in volume-space
-			const float3 p0 = pTmp0 * v->GetHScales();
-			const float3 p1 = pTmp1 * v->GetHScales();
-			// get the distances from the start of the ray
-			// to the intersection points in volume-space
-			const float dSq0 = (p0 - pi0).SqLength();
-			const float dSq1 = (p1 - pi0).SqLength();
-			// if one of the intersection points is closer to p0
-			// than the end of the ray segment, the hit is valid
-			const int b0 = (t0 > 0.0f && dSq0 <= segLenSq) * CQ_POINT_ON_RAY;
-			const int b1 = (t1 > 0.0f && dSq1 <= segLenSq) * CQ_POINT_ON_RAY;
-
-			if (q != nullptr) {
-				q->b0 = b0; q->b1 = b1;
-				q->t0 = t0; q->t1 = t1;
-				q->p0 = p0; q->p1 = p1;
-			}
+	batch.IntersectEllipsoids(cqs, hits);
+
+	for (size_t i = 0; i < batch.Size(); i++) {
+		if (batch.GetLaneState(i) != CollisionVolumeBatch::LANE_NARROW)
+			continue;
 
-			return (b0 == CQ_POINT_ON_RAY || b1 == CQ_POINT_ON_RAY);
+		const CollisionVolume* v = static_cast<const CollisionVolume*>(batch.GetLaneData(i));
+
+		switch (batch.GetLaneType(i)) {
+			case CollisionVolume::COLVOL_TYPE_CYLINDER: {
+				hits[i] = CCollisionHandler::IntersectCylinder(v, batch.GetLaneRayStart(i), batch.GetLaneRayEnd(i), &cqs[i]);
+			} break;
+			case CollisionVolume::COLVOL_TYPE_BOX: {
+				hits[i] = CCollisionHandler::IntersectBox(v, batch.GetLaneRayStart(i), batch.GetLaneRayEnd(i), &cqs[i]);
+			} break;
+			default: {
+				// ellipsoids and spheres were handled by the batch kernel
+			} break;
 		}
+
+		CollisionQuery& q = cqs[i];
+
+		if (q.b0 != CQ_POINT_ON_RAY && q.b1 != CQ_POINT_ON_RAY)
+			continue;
+
+		const CMatrix44f m = batch.GetLaneMatrix(i);
+
+		if (q.b0 == CQ_POINT_ON_RAY) { q.p0 = m.Mul(q.p0); }
+		if (q.b1 == CQ_POINT_ON_RAY) { q.p1 = m.Mul(q.p1); }
 	}
+}
 
-	return false;
+bool CCollisionHandler::IntersectEllipsoid(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* q)
+{
+	// shared with the batched kernel, which must stay bit-identical to it
+	return (CollisionVolumeBatch::IntersectEllipsoid(v->GetHScales(), v->GetHIScales(), pi0, pi1, q));
 }
 
 bool CCollisionHandler::IntersectCylinder(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* q)
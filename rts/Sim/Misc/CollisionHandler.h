@@ -11,6 +11,7 @@
 class CSolidObject;
 struct LocalModelPiece;
 struct CollisionVolume;
+struct CollisionVolumeBatch;
 class CMatrix44f;
 
 enum {
@@ -62,6 +63,7 @@ public:
 
 private:
 	friend class CCollisionHandler;
+	friend struct CollisionVolumeBatch;
 
 	int    b0, b1;        ///< true (non-zero) if ingress (b0) or egress (b1) point on ray segment
 	float  t0, t1;        ///< distance parameter for ingress and egress point
@@ -147,6 +149,15 @@ class CCollisionHandler {
 		static bool IntersectPiecesHelper(const CSolidObject* o, const CMatrix44f& m, const float3& p0, const float3& p1, CollisionQuery* cqp);
 
 	public:
+		/**
+		 * Test a ray against every volume in a batch; equivalent to calling
+		 * Intersect(v, m, p0, p1, &cqs[i]) for each lane i (with v and m as
+		 * passed to CollisionVolumeBatch::Add) and bit-identical with it.
+		 * Lane data must point to the lane's CollisionVolume, queries must
+		 * be reset by the caller.
+		 */
+		static void IntersectBatch(CollisionVolumeBatch& batch, const float3& p0, const float3& p1, CollisionQuery* cqs, bool* hits);
+
 		static bool IntersectEllipsoid(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* cq);
 		static bool IntersectCylinder(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* cq);
 		static bool IntersectBox(const CollisionVolume* v, const float3& pi0, const float3& pi1, CollisionQuery* cq);
@@ -0,0 +1,380 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "CollisionVolumeBatch.h"
+#include "CollisionHandler.h"
+#include "CollisionVolume.h"
+#include "System/FastMath.h"
+#include "System/MainDefines.h"
+
+#include <cassert>
+#include <cstring>
+#include <xmmintrin.h>
+
+// NOTE:
+//   every kernel below must mirror its scalar counterpart operation by
+//   operation (no reassociation, no fused multiply-adds, no approximate
+//   SSE reciprocals) or synced hit-detection would diverge between the
+//   batched and non-batched paths; the approximate square roots used by
+//   IntersectEllipsoid rely on integer tricks which SSE1 cannot express,
+//   so those are evaluated per lane with the same fastmath functions
+
+static inline bool IsEllipsoidType(int type) {
+	return (type == CollisionVolume::COLVOL_TYPE_ELLIPSOID || type == CollisionVolume::COLVOL_TYPE_SPHERE);
+}
+
+// dot(a, b) as float3::dot computes it
+static inline __m128 Dot3(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz) {
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+}
+
+// float4 CMatrix44f::operator* with w=1 (m[12..14] * 1.0f is exact)
+static inline __m128 MulRow(const float* row, size_t i, __m128 x, __m128 y, __m128 z) {
+	__m128 out;
+	out =                 _mm_mul_ps(_mm_load_ps(&row[0 * CollisionVolumeBatch::NUM_LANES + i]), x) ;
+	out = _mm_add_ps(out, _mm_mul_ps(_mm_load_ps(&row[1 * CollisionVolumeBatch::NUM_LANES + i]), y));
+	out = _mm_add_ps(out, _mm_mul_ps(_mm_load_ps(&row[2 * CollisionVolumeBatch::NUM_LANES + i]), z));
+	out = _mm_add_ps(out,            _mm_load_ps(&row[3 * CollisionVolumeBatch::NUM_LANES + i])    );
+	return out;
+}
+
+
+
+size_t CollisionVolumeBatch::Add(const CMatrix44f& volMat, const float3& hs, const float3& his, int type, const void* data)
+{
+	assert(numLanes < NUM_LANES);
+
+	const size_t i = numLanes++;
+	const CMatrix44f invMat = volMat.InvertAffine();
+
+	// store rows of the (column-major) inverse, one per output component
+	for (int r = 0; r < 3; r++) {
+		invMats[r * 4 + 0][i] = invMat[ 0 + r];
+		invMats[r * 4 + 1][i] = invMat[ 4 + r];
+		invMats[r * 4 + 2][i] = invMat[ 8 + r];
+		invMats[r * 4 + 3][i] = invMat[12 + r];
+	}
+	for (int a = 0; a < 3; a++) {
+		hScales[a][i] = hs[a];
+		hiScales[a][i] = his[a];
+	}
+
+	std::memcpy(laneMats[i], &volMat.m[0], sizeof(laneMats[i]));
+	laneData[i] = data;
+	laneTypes[i] = type;
+	laneStates[i] = LANE_MISS;
+	return i;
+}
+
+
+CMatrix44f CollisionVolumeBatch::GetLaneMatrix(size_t i) const
+{
+	CMatrix44f mat;
+	std::memcpy(&mat.m[0], laneMats[i], sizeof(laneMats[i]));
+	return mat;
+}
+
+
+__FORCE_ALIGN_STACK__
+size_t CollisionVolumeBatch::TransformRay(const float3& p0, const float3& p1)
+{
+	// pad the last group with harmless (identity, unit-sized) lanes
+	for (size_t i = numLanes, n = (numLanes + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1); i < n; i++) {
+		for (int k = 0; k < 12; k++) {
+			invMats[k][i] = float((k % 5) == 0);
+		}
+		for (int a = 0; a < 3; a++) {
+			hScales[a][i] = 1.0f;
+			hiScales[a][i] = 1.0f;
+		}
+
+		laneStates[i] = LANE_MISS;
+	}
+
+	const __m128 p0x = _mm_set1_ps(p0.x), p0y = _mm_set1_ps(p0.y), p0z = _mm_set1_ps(p0.z);
+	const __m128 p1x = _mm_set1_ps(p1.x), p1y = _mm_set1_ps(p1.y), p1z = _mm_set1_ps(p1.z);
+	const __m128 sgn = _mm_set1_ps(-0.0f);
+
+	size_t numNarrow = 0;
+
+	for (size_t i = 0; i < numLanes; i += SIMD_WIDTH) {
+		__m128 pi0[3];
+		__m128 pi1[3];
+		__m128 miss = _mm_setzero_ps();
+
+		for (int a = 0; a < 3; a++) {
+			pi0[a] = MulRow(invMats[a * 4], i, p0x, p0y, p0z);
+			pi1[a] = MulRow(invMats[a * 4], i, p1x, p1y, p1z);
+
+			_mm_store_ps(&rays[a    ][i], pi0[a]);
+			_mm_store_ps(&rays[a + 3][i], pi1[a]);
+
+			// operand order matches std::min(pi0, pi1) and std::max(pi0, pi1)
+			const __m128 rmin = _mm_min_ps(pi1[a], pi0[a]);
+			const __m128 rmax = _mm_max_ps(pi1[a], pi0[a]);
+			const __m128 vmax = _mm_load_ps(&hScales[a][i]);
+			const __m128 vmin = _mm_xor_ps(vmax, sgn);
+
+			miss = _mm_or_ps(miss, _mm_cmplt_ps(rmax, vmin));
+			miss = _mm_or_ps(miss, _mm_cmpgt_ps(rmin, vmax));
+		}
+
+		const int missMask = _mm_movemask_ps(miss);
+
+		for (size_t j = 0; j < SIMD_WIDTH && (i + j) < numLanes; j++) {
+			laneStates[i + j] = ((missMask >> j) & 1)? LANE_MISS: LANE_NARROW;
+			numNarrow += (laneStates[i + j] == LANE_NARROW);
+		}
+	}
+
+	return numNarrow;
+}
+
+
+__FORCE_ALIGN_STACK__
+void CollisionVolumeBatch::IntersectEllipsoids(CollisionQuery* cqs, bool* hits) const
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 two = _mm_set1_ps(2.0f);
+	const __m128 four = _mm_set1_ps(4.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 sgn = _mm_set1_ps(-0.0f);
+	const __m128 eps = _mm_set1_ps(COLLISION_VOLUME_EPS);
+	const __m128 nrmEps = _mm_set1_ps(float3::nrm_eps());
+
+	alignas(16) float tmp[4];
+
+	for (size_t i = 0; i < numLanes; i += SIMD_WIDTH) {
+		int laneMask = 0;
+
+		for (size_t j = 0; j < SIMD_WIDTH && (i + j) < numLanes; j++) {
+			laneMask |= ((laneStates[i + j] == LANE_NARROW && IsEllipsoidType(laneTypes[i + j])) << j);
+		}
+
+		if (laneMask == 0)
+			continue;
+
+		__m128 pi0[3], pi1[3], pii0[3], pii1[3], dir[3], hs[3];
+
+		for (int a = 0; a < 3; a++) {
+			const __m128 his = _mm_load_ps(&hiScales[a][i]);
+
+			hs[a] = _mm_load_ps(&hScales[a][i]);
+			pi0[a] = _mm_load_ps(&rays[a    ][i]);
+			pi1[a] = _mm_load_ps(&rays[a + 3][i]);
+			pii0[a] = _mm_mul_ps(pi0[a], his);
+			pii1[a] = _mm_mul_ps(pi1[a], his);
+			dir[a] = _mm_sub_ps(pii1[a], pii0[a]);
+		}
+
+		const __m128 piiSq = Dot3(pii0[0], pii0[1], pii0[2], pii0[0], pii0[1], pii0[2]);
+		const __m128 inside = _mm_cmple_ps(piiSq, one);
+
+		{
+			// float3::SafeNormalize
+			const __m128 sql = Dot3(dir[0], dir[1], dir[2], dir[0], dir[1], dir[2]);
+			const __m128 nrm = _mm_cmpgt_ps(sql, nrmEps);
+
+			_mm_store_ps(tmp, sql);
+
+			for (int j = 0; j < 4; j++)
+				tmp[j] = math::isqrt(tmp[j]);
+
+			const __m128 isq = _mm_load_ps(tmp);
+
+			for (int a = 0; a < 3; a++) {
+				dir[a] = _mm_or_ps(_mm_and_ps(nrm, _mm_mul_ps(dir[a], isq)), _mm_andnot_ps(nrm, dir[a]));
+			}
+		}
+
+		const __m128 B = _mm_mul_ps(two, Dot3(pii0[0], pii0[1], pii0[2], dir[0], dir[1], dir[2]));
+		const __m128 C = _mm_sub_ps(piiSq, one);
+		const __m128 D = _mm_sub_ps(_mm_mul_ps(B, B), _mm_mul_ps(four, C));
+		const __m128 negB = _mm_xor_ps(B, sgn);
+
+		// one solution iff D < eps, none iff D < -eps
+		const __m128 noSol = _mm_cmplt_ps(D, _mm_xor_ps(eps, sgn));
+		const __m128 oneSol = _mm_cmplt_ps(D, eps);
+
+		_mm_store_ps(tmp, D);
+
+		// only lanes with two solutions use rD
+		for (int j = 0; j < 4; j++)
+			tmp[j] = (tmp[j] >= COLLISION_VOLUME_EPS)? fastmath::apxsqrt(tmp[j]): 0.0f;
+
+		const __m128 rD = _mm_load_ps(tmp);
+
+		const __m128 tOne = _mm_mul_ps(negB, half);
+		const __m128 tTwo0 = _mm_mul_ps(_mm_sub_ps(negB, rD), half);
+		const __m128 tTwo1 = _mm_mul_ps(_mm_add_ps(negB, rD), half);
+
+		const __m128 t0 = _mm_or_ps(_mm_and_ps(oneSol, tOne), _mm_andnot_ps(oneSol, tTwo0));
+		const __m128 t1 = tTwo1;
+
+		__m128 p0[3], p1[3], d0[3], d1[3], seg[3];
+
+		for (int a = 0; a < 3; a++) {
+			p0[a] = _mm_mul_ps(_mm_add_ps(pii0[a], _mm_mul_ps(dir[a], t0)), hs[a]);
+			p1[a] = _mm_mul_ps(_mm_add_ps(pii0[a], _mm_mul_ps(dir[a], t1)), hs[a]);
+			d0[a] = _mm_sub_ps(p0[a], pi0[a]);
+			d1[a] = _mm_sub_ps(p1[a], pi0[a]);
+			seg[a] = _mm_sub_ps(pi1[a], pi0[a]);
+		}
+
+		const __m128 segLenSq = Dot3(seg[0], seg[1], seg[2], seg[0], seg[1], seg[2]);
+		const __m128 dSq0 = Dot3(d0[0], d0[1], d0[2], d0[0], d0[1], d0[2]);
+		const __m128 dSq1 = Dot3(d1[0], d1[1], d1[2], d1[0], d1[1], d1[2]);
+
+		const int b0Mask = _mm_movemask_ps(_mm_and_ps(_mm_cmpgt_ps(t0, zero), _mm_cmple_ps(dSq0, segLenSq)));
+		const int b1Mask = _mm_movemask_ps(_mm_and_ps(_mm_cmpgt_ps(t1, zero), _mm_cmple_ps(dSq1, segLenSq))) & ~_mm_movemask_ps(oneSol);
+
+		const int insideMask = _mm_movemask_ps(inside);
+		const int noSolMask = _mm_movemask_ps(noSol);
+		const int oneSolMask = _mm_movemask_ps(oneSol);
+
+		alignas(16) float outT[2][4];
+		alignas(16) float outP[6][4];
+
+		_mm_store_ps(outT[0], t0);
+		_mm_store_ps(outT[1], t1);
+
+		for (int a = 0; a < 3; a++) {
+			_mm_store_ps(outP[a    ], p0[a]);
+			_mm_store_ps(outP[a + 3], p1[a]);
+		}
+
+		for (int j = 0; j < 4; j++) {
+			if (((laneMask >> j) & 1) == 0)
+				continue;
+
+			CollisionQuery& q = cqs[i + j];
+
+			if ((insideMask >> j) & 1) {
+				q.b0 = CQ_POINT_IN_VOL; q.p0 = ZeroVector;
+				q.b1 = CQ_POINT_IN_VOL; q.p1 = ZeroVector;
+				hits[i + j] = true;
+				continue;
+			}
+
+			if ((noSolMask >> j) & 1) {
+				hits[i + j] = false;
+				continue;
+			}
+
+			const int b0 = ((b0Mask >> j) & 1) * CQ_POINT_ON_RAY;
+			const int b1 = ((b1Mask >> j) & 1) * CQ_POINT_ON_RAY;
+
+			q.b0 = b0;
+			q.b1 = b1;
+			q.t0 = outT[0][j];
+			q.p0 = float3(outP[0][j], outP[1][j], outP[2][j]);
+
+			if ((oneSolMask >> j) & 1) {
+				q.t1 = 0.0f;
+				q.p1 = ZeroVector;
+			} else {
+				q.t1 = outT[1][j];
+				q.p1 = float3(outP[3][j], outP[4][j], outP[5][j]);
+			}
+
+			hits[i + j] = (b0 == CQ_POINT_ON_RAY || b1 == CQ_POINT_ON_RAY);
+		}
+	}
+}
+
+
+bool CollisionVolumeBatch::IntersectEllipsoid(const float3& hs, const float3& his, const float3& pi0, const float3& pi1, CollisionQuery* q)
+{
+	// transform the volume-space points into (unit) sphere-space (requires fewer
+	// float-ops than solving the surface equation for arbitrary ellipsoid volumes)
+	const float3 pii0 = pi0 * his;
+	const float3 pii1 = pi1 * his;
+	const float rSq = 1.0f;
+
+	if (pii0.dot(pii0) <= rSq) {
+		if (q != nullptr) {
+			// terminate early in the special case
+			// that ray-segment originated *in* <v>
+			// (these points are NOT transformed!)
+			q->b0 = CQ_POINT_IN_VOL; q->p0 = ZeroVector;
+			q->b1 = CQ_POINT_IN_VOL; q->p1 = ZeroVector;
+		}
+		return true;
+	}
+
+	// get the ray direction in unit-sphere space
+	const float3 dir = (pii1 - pii0).SafeNormalize();
+
+	// solves [ x^2 + y^2 + z^2 == r^2 ] for t; closest
+	// point on ray is p(t) = p0 + (p1-p0)*t = p0 + d*t
+	// (A represents dir.dot(dir), which equals 1 since
+	// the ray direction is already normalized)
+	// const float A = (pii1 - pii0).dot(pii1 - pii0);
+	// const float B = 2.0f * pii0.dot(pii1 - pii0);
+	const float A = 1.0f;
+	const float B = 2.0f * pii0.dot(dir);
+	const float C = pii0.dot(pii0) - rSq;
+	const float D = (B * B) - (4.0f * A * C);
+
+	if (D < -COLLISION_VOLUME_EPS) {
+		return false;
+	} else {
+		// get the length of the ray segment in volume-space
+		const float segLenSq = (pi1 - pi0).SqLength();
+
+		if (D < COLLISION_VOLUME_EPS) {
+			// one solution for t
+			const float t0 = -B * 0.5f;
+			// const float t0 = -B / (2.0f * A);
+			// get the intersection point in sphere-space
+			const float3 pTmp = pii0 + (dir * t0);
+			// get the intersection point in volume-space
+			const float3 p0 = pTmp * hs;
+			// get the distance from the start of the segment
+			// to the intersection point in volume-space
+			const float dSq0 = (p0 - pi0).SqLength();
+			// if the intersection point is closer to p0 than
+			// the end of the ray segment, the hit is valid
+			const int b0 = (t0 > 0.0f && dSq0 <= segLenSq) * CQ_POINT_ON_RAY;
+
+			if (q != nullptr) {
+				q->b0 = b0; q->b1 = CQ_POINT_NO_INT;
+				q->t0 = t0; q->t1 = 0.0f;
+				q->p0 = p0; q->p1 = ZeroVector;
+			}
+
+			return (b0 == CQ_POINT_ON_RAY);
+		} else {
+			// two solutions for t
+			const float rD = fastmath::apxsqrt(D);
+			const float t0 = (-B - rD) * 0.5f;
+			const float t1 = (-B + rD) * 0.5f;
+			// const float t0 = (-B + rD) / (2.0f * A);
+			// const float t1 = (-B - rD) / (2.0f * A);
+			// get the intersection points in sphere-space
+			const float3 pTmp0 = pii0 + (dir * t0);
+			const float3 pTmp1 = pii0 + (dir * t1);
+			// get the intersection points in volume-space
+			const float3 p0 = pTmp0 * hs;
+			const float3 p1 = pTmp1 * hs;
+			// get the distances from the start of the ray
+			// to the intersection points in volume-space
+			const float dSq0 = (p0 - pi0).SqLength();
+			const float dSq1 = (p1 - pi0).SqLength();
+			// if one of the intersection points is closer to p0
+			// than the end of the ray segment, the hit is valid
+			const int b0 = (t0 > 0.0f && dSq0 <= segLenSq) * CQ_POINT_ON_RAY;
+			const int b1 = (t1 > 0.0f && dSq1 <= segLenSq) * CQ_POINT_ON_RAY;
+
+			if (q != nullptr) {
+				q->b0 = b0; q->b1 = b1;
+				q->t0 = t0; q->t1 = t1;
+				q->p0 = p0; q->p1 = p1;
+			}
+
+			return (b0 == CQ_POINT_ON_RAY || b1 == CQ_POINT_ON_RAY);
+		}
+	}
+
+	return false;
+}
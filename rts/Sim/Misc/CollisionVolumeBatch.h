@@ -0,0 +1,96 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef COLLISION_VOLUME_BATCH_H
+#define COLLISION_VOLUME_BATCH_H
+
+#include "System/float3.h"
+#include "System/Matrix44f.h"
+
+#include <cstddef>
+#include <cstdint>
+
+struct CollisionQuery;
+
+/**
+ * Fixed-capacity structure-of-arrays set of collision volumes that a
+ * single ray is tested against in one pass, four lanes at a time (SSE).
+ *
+ * All kernels perform exactly the same float operations in the same order
+ * as the scalar CCollisionHandler code-paths, so results are bit-identical
+ * and the batch may be used in synced code.
+ */
+struct CollisionVolumeBatch {
+public:
+	static constexpr size_t NUM_LANES = 32;
+	static constexpr size_t SIMD_WIDTH = 4;
+
+	enum {
+		LANE_MISS = 0, ///< ray misses the volume's bounding box
+		LANE_NARROW = 1, ///< ray overlaps bounding box, needs narrow-phase test
+	};
+
+public:
+	void Clear() { numLanes = 0; }
+
+	bool Full() const { return (numLanes == NUM_LANES); }
+	bool Empty() const { return (numLanes == 0); }
+	size_t Size() const { return numLanes; }
+
+	/**
+	 * @param volMat volume-to-world transform (CV offsets already applied)
+	 * @param hs half-length axis scales of the volume
+	 * @param his inverted half-length axis scales of the volume
+	 * @param type one of CollisionVolume::COLVOL_TYPE_*
+	 * @param data opaque caller pointer (e.g. the CollisionVolume itself)
+	 * @return lane index
+	 */
+	size_t Add(const CMatrix44f& volMat, const float3& hs, const float3& his, int type, const void* data);
+
+	/**
+	 * Transforms the world-space segment <p0, p1> into the space of every
+	 * lane and rejects lanes whose bounding box it misses, exactly like the
+	 * scalar CCollisionHandler::Intersect.
+	 * @return number of lanes that need a narrow-phase test
+	 */
+	size_t TransformRay(const float3& p0, const float3& p1);
+
+	/**
+	 * Narrow-phase test for all LANE_NARROW lanes of ellipsoid or sphere type,
+	 * equivalent to CCollisionHandler::IntersectEllipsoid. Writes the query of
+	 * each tested lane to cqs[lane] (in volume-space) and its result to hits.
+	 * Lanes of other types are left untouched.
+	 */
+	void IntersectEllipsoids(CollisionQuery* cqs, bool* hits) const;
+
+	/// scalar volume-space ray vs. ellipsoid test (the reference for the batch kernel)
+	static bool IntersectEllipsoid(const float3& hs, const float3& his, const float3& pi0, const float3& pi1, CollisionQuery* q);
+
+	int GetLaneState(size_t i) const { return laneStates[i]; }
+	int GetLaneType(size_t i) const { return laneTypes[i]; }
+
+	const void* GetLaneData(size_t i) const { return laneData[i]; }
+	CMatrix44f GetLaneMatrix(size_t i) const;
+
+	float3 GetLaneRayStart(size_t i) const { return {rays[0][i], rays[1][i], rays[2][i]}; }
+	float3 GetLaneRayEnd(size_t i) const { return {rays[3][i], rays[4][i], rays[5][i]}; }
+
+private:
+	// inverse (world-to-volume) transforms: [0..3] := x-row, [4..7] := y-row, [8..11] := z-row
+	alignas(16) float invMats[12][NUM_LANES];
+	alignas(16) float hScales[3][NUM_LANES];
+	alignas(16) float hiScales[3][NUM_LANES];
+	// ray start- and end-points in volume-space, written by TransformRay
+	alignas(16) float rays[6][NUM_LANES];
+
+	// forward (volume-to-world) transforms, only needed for hits; kept as
+	// raw floats since CMatrix44f's constructor would load an identity
+	float laneMats[NUM_LANES][16];
+	const void* laneData[NUM_LANES];
+
+	int laneTypes[NUM_LANES];
+	uint8_t laneStates[NUM_LANES];
+
+	size_t numLanes = 0;
+};
+
+#endif
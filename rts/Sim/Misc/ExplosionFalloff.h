@@ -0,0 +1,49 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef EXPLOSION_FALLOFF_H
+#define EXPLOSION_FALLOFF_H
+
+#include <algorithm>
+#include <cstddef>
+#include <xmmintrin.h>
+
+namespace ExplosionFalloff {
+	/**
+	 * Linear damage falloff with distance from the explosion center,
+	 * softened by the edge-effectiveness. expEdgeEffect should be in
+	 * [0, 1] and expDist <= expRadius, giving a result in [0, 1].
+	 */
+	static inline float CalcDistanceMod(float expRadius, float expDist, float expEdgeEffect) {
+		const float expRim = expDist * expEdgeEffect;
+		return ((expRadius + 0.001f - expDist) / (expRadius + 0.001f - expRim));
+	}
+
+	/**
+	 * CalcDistanceMod for <count> distances at once, four at a time.
+	 * Uses exactly the same (correctly rounded) float operations in the
+	 * same order as the scalar version, so results are bit-identical
+	 * and usable in synced code. Distances beyond expRadius are clamped
+	 * to it (avoiding spurious FP exceptions), callers must skip those.
+	 */
+	static inline void CalcDistanceMods(const float* expDists, float* expMods, size_t count, float expRadius, float expEdgeEffect) {
+		const __m128 maxDist = _mm_set1_ps(expRadius);
+		const __m128 rad = _mm_set1_ps(expRadius + 0.001f);
+		const __m128 edge = _mm_set1_ps(expEdgeEffect);
+
+		size_t i = 0;
+
+		for (; (i + 4) <= count; i += 4) {
+			// operand order keeps NaN's like the scalar path does
+			const __m128 dist = _mm_min_ps(maxDist, _mm_loadu_ps(&expDists[i]));
+			const __m128 rim = _mm_mul_ps(dist, edge);
+
+			_mm_storeu_ps(&expMods[i], _mm_div_ps(_mm_sub_ps(rad, dist), _mm_sub_ps(rad, rim)));
+		}
+
+		for (; i < count; i++) {
+			expMods[i] = CalcDistanceMod(expRadius, std::min(expDists[i], expRadius), expEdgeEffect);
+		}
+	}
+}
+
+#endif
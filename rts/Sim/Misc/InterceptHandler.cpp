@@ -6,6 +6,7 @@
 #include "InterceptHandler.h"
 
 #include "Map/Ground.h"
+#include "Map/ReadMap.h"
 #include "Sim/Weapons/Weapon.h"
 #include "Sim/Projectiles/WeaponProjectiles/WeaponProjectile.h"
 #include "Sim/Units/Unit.h"
@@ -20,24 +21,49 @@
 CR_BIND_DERIVED(CInterceptHandler, CObject, )
 CR_REG_METADATA(CInterceptHandler, (
 	CR_MEMBER(interceptors),
-	CR_MEMBER(interceptables)
+	CR_MEMBER(interceptables),
+	CR_IGNORED(targetBuckets),
+	CR_IGNORED(targetQueryIndices),
+	CR_IGNORED(candidateTargets),
+	CR_IGNORED(numBucketsX),
+	CR_IGNORED(numBucketsZ)
 ))
 
 CInterceptHandler interceptHandler;
 
+// edge-length of a target bucket in elmos
+static constexpr float TARGET_BUCKET_SIZE = SQUARE_SIZE * 64.0f;
+
 
 
 void CInterceptHandler::Update(bool forced) {
 	if (((gs->frameNum % UNIT_SLOWUPDATE_RATE) != 0) && !forced)
 		return;
 
-	for (CWeapon* w: interceptors) {
+	if (interceptors.empty() || interceptables.empty())
+		return;
+
+	BucketInterceptTargets();
+
+	// visit pairs in the same (interceptor-major, then target) order as
+	// an all-pairs scan would, only skipping targets that can not be in
+	// range; the order matters for Lua and the weapons' incoming lists
+	for (size_t i = 0; i < interceptors.size(); i++) {
+		CWeapon* w = interceptors[i];
+
 		const WeaponDef* wDef = w->weaponDef;
 		const CUnit* wOwner = w->owner;
 
 		assert(wDef->interceptor || wDef->isShield);
 
-		for (CWeaponProjectile* p: interceptables) {
+		if (wDef->coverageRange <= 0.0f)
+			continue;
+
+		GetBucketTargets(w->aimFromPos, wDef->coverageRange, i);
+
+		for (const int targetIdx: candidateTargets) {
+			CWeaponProjectile* p = interceptables[targetIdx];
+
 			if (!p->CanBeInterceptedBy(wDef))
 				continue;
 			if (w->HasIncomingProjectile(p->id))
@@ -48,69 +74,189 @@ void CInterceptHandler::Update(bool forced) {
 			if (teamHandler->IsValidAllyTeam(pAllyTeam) && teamHandler->Ally(wOwner->allyteam, pAllyTeam))
 				continue;
 
+			if (!InterceptorCoversTarget(w, p))
+				continue;
+
 			// note: will be called every Update so long as gadget does not return true
+			// (and the projectile is within coverage)
 			if (!eventHandler.AllowWeaponInterceptTarget(wOwner, w, p))
 				continue;
 
-			// there are four cases when an interceptor <w> should fire at a projectile <p>:
-			//     1. p's target position inside w's interception circle (w's owner can move!)
-			//     2. p's current position inside w's interception circle
-			//     3. p's projected impact position inside w's interception circle
-			//     4. p's trajectory intersects w's interception circle
-			//
-			// these checks all need to be evaluated periodically, not just
-			// when a projectile is created and handed to AddInterceptTarget
-			const float weaponDist = w->aimFromPos.distance(p->pos);
-			const float impactDist = CGround::LineGroundCol(p->pos, p->pos + p->dir * weaponDist);
-
-			const float3& pImpactPos = p->pos + p->dir * impactDist;
-			const float3& pTargetPos = p->GetTargetPos();
-			const float3  pWeaponVec = p->pos - w->aimFromPos;
-
-			if (w->aimFromPos.SqDistance2D(pTargetPos) < Square(wDef->coverageRange)) {
-				w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
-				w->AddIncomingProjectile(p->id);
-				continue; // 1
-			}
+			w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
+			w->AddIncomingProjectile(p->id);
+		}
+	}
+}
+
+
+bool CInterceptHandler::InterceptorCoversTarget(const CWeapon* w, const CWeaponProjectile* p)
+{
+	const WeaponDef* wDef = w->weaponDef;
+
+	// there are four cases when an interceptor <w> should fire at a projectile <p>:
+	//     1. p's target position inside w's interception circle (w's owner can move!)
+	//     2. p's current position inside w's interception circle
+	//     3. p's projected impact position inside w's interception circle
+	//     4. p's trajectory intersects w's interception circle
+	//
+	// these checks all need to be evaluated periodically, not just
+	// when a projectile is created and handed to AddInterceptTarget
+	const float weaponDist = w->aimFromPos.distance(p->pos);
+	const float impactDist = CGround::LineGroundCol(p->pos, p->pos + p->dir * weaponDist);
+
+	const float3& pImpactPos = p->pos + p->dir * impactDist;
+	const float3& pTargetPos = p->GetTargetPos();
+	const float3  pWeaponVec = p->pos - w->aimFromPos;
+
+	if (w->aimFromPos.SqDistance2D(pTargetPos) < Square(wDef->coverageRange))
+		return true; // 1
+
+	if (false /*wDef->noFlyThroughIntercept*/) {
+		// <w> is just a static interceptor and fires only at projectiles
+		// TARGETED within its current interception area; any projectiles
+		// CROSSING its interception area aren't targeted
+		//XXX implement in lua?
+		return false;
+	}
+
+	if (pWeaponVec.SqLength2D() < Square(wDef->coverageRange))
+		return true; // 2
+
+	if (w->aimFromPos.SqDistance2D(pImpactPos) < Square(wDef->coverageRange)) {
+		const float3 pTargetDir = (pTargetPos - p->pos).SafeNormalize();
+		const float3 pImpactDir = (pImpactPos - p->pos).SafeNormalize();
+
+		// the projected impact position can briefly shift into the covered
+		// area during transition from vertical to horizontal flight, so we
+		// perform an extra test (NOTE: assumes non-parabolic trajectory)
+		if (pTargetDir.dot(pImpactDir) >= 0.999f)
+			return true; // 3
+	}
+
+	const float3 pMinSepPos = p->pos + p->dir * Clamp(-(pWeaponVec.dot(p->dir)), 0.0f, impactDist);
+	const float3 pMinSepVec = w->aimFromPos - pMinSepPos;
+
+	return (pMinSepVec.SqLength() < Square(wDef->coverageRange)); // 4
+}
+
+
+void CInterceptHandler::BucketInterceptTargets()
+{
+	const float mapSizeX = mapDims.mapx * SQUARE_SIZE;
+	const float mapSizeZ = mapDims.mapy * SQUARE_SIZE;
+
+	numBucketsX = std::max(1, int(math::ceil(mapSizeX / TARGET_BUCKET_SIZE)));
+	numBucketsZ = std::max(1, int(math::ceil(mapSizeZ / TARGET_BUCKET_SIZE)));
+
+	targetBuckets.resize(numBucketsX * numBucketsZ);
+	targetQueryIndices.clear();
+	targetQueryIndices.resize(interceptables.size(), -1);
+
+	for (auto& bucket: targetBuckets) {
+		bucket.clear();
+	}
+
+	float maxCoverage = 0.0f;
+
+	for (const CWeapon* w: interceptors) {
+		maxCoverage = std::max(maxCoverage, w->weaponDef->coverageRange);
+	}
+
+	// trajectory points further than this outside the map can not be covered
+	// by any interceptor (positions off the map are clamped to edge buckets)
+	const float margin = maxCoverage + TARGET_BUCKET_SIZE;
+	const float rectMin[2] = {           -margin,            -margin};
+	const float rectMax[2] = {mapSizeX + margin, mapSizeZ + margin};
+
+	for (size_t i = 0; i < interceptables.size(); i++) {
+		const CWeaponProjectile* p = interceptables[i];
+
+		// all points any of the four coverage tests can look at lie on
+		// p's 2D ray (including one step behind p) or at its target; the
+		// ray is sampled once per bucket-length, GetBucketTargets widens
+		// its queries by the same amount to account for the gaps
+		AddBucketTarget(i, p->GetTargetPos());
+		AddBucketTarget(i, p->pos - p->dir);
+		AddBucketTarget(i, p->pos);
+
+		const float dirLen2D = p->dir.Length2D();
+
+		if (dirLen2D < 0.001f)
+			continue;
+
+		// clip the ray against the (extended) map rectangle
+		float tMin = 0.0f;
+		float tMax = std::numeric_limits<float>::max();
+
+		for (int a = 0; a < 2; a++) {
+			const float o = p->pos[a * 2];
+			const float d = p->dir[a * 2];
+
+			if (math::fabs(d) < 0.0001f) {
+				if (o < rectMin[a] || o > rectMax[a])
+					tMax = -1.0f;
 
-			if (false /*wDef->noFlyThroughIntercept*/) {
-				// <w> is just a static interceptor and fires only at projectiles
-				// TARGETED within its current interception area; any projectiles
-				// CROSSING its interception area aren't targeted
-				//XXX implement in lua?
 				continue;
 			}
 
-			if (pWeaponVec.SqLength2D() < Square(wDef->coverageRange)) {
-				w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
-				w->AddIncomingProjectile(p->id);
-				continue; // 2
-			}
+			const float t0 = (rectMin[a] - o) / d;
+			const float t1 = (rectMax[a] - o) / d;
 
-			if (w->aimFromPos.SqDistance2D(pImpactPos) < Square(wDef->coverageRange)) {
-				const float3 pTargetDir = (pTargetPos - p->pos).SafeNormalize();
-				const float3 pImpactDir = (pImpactPos - p->pos).SafeNormalize();
-
-				// the projected impact position can briefly shift into the covered
-				// area during transition from vertical to horizontal flight, so we
-				// perform an extra test (NOTE: assumes non-parabolic trajectory)
-				if (pTargetDir.dot(pImpactDir) >= 0.999f) {
-					w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
-					w->AddIncomingProjectile(p->id);
-					continue; // 3
-				}
-			}
+			tMin = std::max(tMin, std::min(t0, t1));
+			tMax = std::min(tMax, std::max(t0, t1));
+		}
+
+		const float tStep = TARGET_BUCKET_SIZE / dirLen2D;
+
+		for (float t = tMin; t <= tMax; t += tStep) {
+			AddBucketTarget(i, p->pos + p->dir * t);
+		}
+
+		if (tMin <= tMax)
+			AddBucketTarget(i, p->pos + p->dir * tMax);
+	}
+}
+
+void CInterceptHandler::AddBucketTarget(int targetIdx, const float3& pos)
+{
+	const int bx = Clamp(int(pos.x / TARGET_BUCKET_SIZE), 0, numBucketsX - 1);
+	const int bz = Clamp(int(pos.z / TARGET_BUCKET_SIZE), 0, numBucketsZ - 1);
+
+	std::vector<int>& bucket = targetBuckets[bz * numBucketsX + bx];
+
+	// consecutive samples mostly fall into the same bucket
+	if (!bucket.empty() && bucket.back() == targetIdx)
+		return;
+
+	bucket.push_back(targetIdx);
+}
+
+void CInterceptHandler::GetBucketTargets(const float3& pos, float radius, int queryIdx)
+{
+	candidateTargets.clear();
+
+	// widen by the ray sampling distance (see BucketInterceptTargets)
+	const float r = radius + TARGET_BUCKET_SIZE;
 
-			const float3 pMinSepPos = p->pos + p->dir * Clamp(-(pWeaponVec.dot(p->dir)), 0.0f, impactDist);
-			const float3 pMinSepVec = w->aimFromPos - pMinSepPos;
+	const int bx0 = Clamp(int((pos.x - r) / TARGET_BUCKET_SIZE), 0, numBucketsX - 1);
+	const int bx1 = Clamp(int((pos.x + r) / TARGET_BUCKET_SIZE), 0, numBucketsX - 1);
+	const int bz0 = Clamp(int((pos.z - r) / TARGET_BUCKET_SIZE), 0, numBucketsZ - 1);
+	const int bz1 = Clamp(int((pos.z + r) / TARGET_BUCKET_SIZE), 0, numBucketsZ - 1);
 
-			if (pMinSepVec.SqLength() < Square(wDef->coverageRange)) {
-				w->AddDeathDependence(p, DEPENDENCE_INTERCEPT);
-				w->AddIncomingProjectile(p->id);
-				continue; // 4
+	for (int bz = bz0; bz <= bz1; bz++) {
+		for (int bx = bx0; bx <= bx1; bx++) {
+			for (const int targetIdx: targetBuckets[bz * numBucketsX + bx]) {
+				if (targetQueryIndices[targetIdx] == queryIdx)
+					continue;
+
+				targetQueryIndices[targetIdx] = queryIdx;
+				candidateTargets.push_back(targetIdx);
 			}
 		}
 	}
+
+	// restore the registration order of interceptables
+	std::sort(candidateTargets.begin(), candidateTargets.end());
 }
 
 
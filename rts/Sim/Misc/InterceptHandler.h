@@ -4,6 +4,8 @@
 #define INTERCEPT_HANDLER_H
 
 #include <deque>
+#include <vector>
+
 #include "System/Misc/NonCopyable.h"
 #include "System/Object.h"
 
@@ -26,9 +28,25 @@ public:
 
 	void DependentDied(CObject* o);
 
+private:
+	void BucketInterceptTargets();
+	void AddBucketTarget(int targetIdx, const float3& pos);
+	void GetBucketTargets(const float3& pos, float radius, int queryIdx);
+
+	static bool InterceptorCoversTarget(const CWeapon* w, const CWeaponProjectile* p);
+
 private:
 	std::deque<CWeapon*> interceptors;
 	std::deque<CWeaponProjectile*> interceptables;
+
+	// indices of interceptables that might pass through each bucket;
+	// rebuilt from synced state on every Update, so not serialized
+	std::vector< std::vector<int> > targetBuckets;
+	std::vector<int> targetQueryIndices;
+	std::vector<int> candidateTargets;
+
+	int numBucketsX = 0;
+	int numBucketsZ = 0;
 };
 
 extern CInterceptHandler interceptHandler;
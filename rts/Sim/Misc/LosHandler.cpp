@@ -239,6 +239,8 @@ inline void ILosType::LosAdd(SLosInstance* li)
 	} else {
 		losMaps[li->allyteam].AddCircle(li, 1);
 	}
+
+	MarkDirty(li);
 }
 
 
@@ -249,6 +251,55 @@ inline void ILosType::LosRemove(SLosInstance* li)
 	} else {
 		losMaps[li->allyteam].AddCircle(li, -1);
 	}
+
+	MarkDirty(li);
+}
+
+
+void ILosType::MarkDirty(const SLosInstance* li)
+{
+	if (dirtyRects.empty())
+		return;
+
+	// raycasted squares never leave the instance's bounding-square either
+	const SRectangle rect(
+		std::max(li->basePos.x - li->radius    , 0),
+		std::max(li->basePos.y - li->radius    , 0),
+		std::min(li->basePos.x + li->radius + 1, size.x),
+		std::min(li->basePos.y + li->radius + 1, size.y)
+	);
+
+	for (std::vector<SRectangle>& consumerRects: dirtyRects) {
+		SRectangle& dirtyRect = consumerRects[li->allyteam];
+
+		if (dirtyRect.GetArea() <= 0) {
+			dirtyRect = rect;
+			continue;
+		}
+
+		dirtyRect.x1 = std::min(dirtyRect.x1, rect.x1);
+		dirtyRect.z1 = std::min(dirtyRect.z1, rect.z1);
+		dirtyRect.x2 = std::max(dirtyRect.x2, rect.x2);
+		dirtyRect.z2 = std::max(dirtyRect.z2, rect.z2);
+	}
+}
+
+
+int ILosType::AddDirtyRectConsumer()
+{
+	dirtyRects.emplace_back(losMaps.size(), SRectangle());
+	return (dirtyRects.size() - 1);
+}
+
+
+SRectangle ILosType::ConsumeDirtyRect(int consumer, int allyTeam)
+{
+	assert(consumer >= 0 && consumer < dirtyRects.size());
+	assert(allyTeam >= 0 && allyTeam < losMaps.size());
+
+	SRectangle rect;
+	std::swap(rect, dirtyRects[consumer][allyTeam]);
+	return rect;
 }
 
 
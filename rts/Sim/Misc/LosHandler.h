@@ -132,6 +132,15 @@ public:
 	void RemoveUnit(CUnit* unit, bool delayed = false);
 	void UpdateUnit(CUnit* unit, bool ignore = false);
 
+	/// registers an (unsynced) reader of the dirty-rectangles, e.g. an info-texture
+	int AddDirtyRectConsumer();
+	/// returns the bounds (in squares) of everything that changed for <allyTeam>
+	/// since this consumer's last call and resets them; empty if nothing did
+	SRectangle ConsumeDirtyRect(int consumer, int allyTeam);
+
+private:
+	void MarkDirty(const SLosInstance* instance);
+
 private:
 	//void PostLoad();
 
@@ -189,6 +198,9 @@ private:
 	std::vector<SLosInstance*> losDeleted;
 	std::vector<SLosInstance*> losRecalc;
 
+	// per consumer and allyteam; each consumer resets only its own copy
+	std::vector< std::vector<SRectangle> > dirtyRects;
+
 	static constexpr int CACHE_SIZE = 4096;
 };
 
@@ -23,12 +23,14 @@ CR_REG_METADATA(CQuadField, (
 	CR_MEMBER(numQuadsZ),
 	CR_MEMBER(quadSizeX),
 	CR_MEMBER(quadSizeZ),
+	CR_MEMBER(numSolidChanges),
 
 	CR_IGNORED(tempUnits),
 	CR_IGNORED(tempFeatures),
 	CR_IGNORED(tempProjectiles),
 	CR_IGNORED(tempSolids),
-	CR_IGNORED(tempQuads)
+	CR_IGNORED(tempQuads),
+	CR_IGNORED(projectileMoves)
 ))
 
 CR_BIND(CQuadField::Quad, )
@@ -304,6 +306,7 @@ void CQuadField::MovedUnit(CUnit* unit)
 	}
 
 	unit->quads = std::move(*qfQuery.quads);
+	numSolidChanges += 1;
 }
 
 void CQuadField::RemoveUnit(CUnit* unit)
@@ -314,6 +317,7 @@ void CQuadField::RemoveUnit(CUnit* unit)
 	}
 
 	unit->quads.clear();
+	numSolidChanges += 1;
 
 	#ifdef DEBUG_QUADFIELD
 	for (const Quad& q: baseQuads) {
@@ -376,6 +380,8 @@ void CQuadField::AddFeature(CFeature* feature)
 	for (const int qi: *qfQuery.quads) {
 		spring::VectorInsertUnique(baseQuads[qi].features, feature, false);
 	}
+
+	numSolidChanges += 1;
 }
 
 void CQuadField::RemoveFeature(CFeature* feature)
@@ -387,6 +393,8 @@ void CQuadField::RemoveFeature(CFeature* feature)
 		spring::VectorErase(baseQuads[qi].features, feature);
 	}
 
+	numSolidChanges += 1;
+
 	#ifdef DEBUG_QUADFIELD
 	for (const Quad& q: baseQuads) {
 		for (CFeature* f: q.features) {
@@ -398,7 +406,7 @@ void CQuadField::RemoveFeature(CFeature* feature)
 
 
 
-void CQuadField::MovedProjectile(CProjectile* p)
+void CQuadField::QueueMovedProjectile(CProjectile* p)
 {
 	if (!p->synced)
 		return;
@@ -407,10 +415,60 @@ void CQuadField::MovedProjectile(CProjectile* p)
 		return;
 
 	const int newQuad = WorldPosToQuadFieldIdx(p->pos);
-	if (newQuad != p->quads.back()) {
-		RemoveProjectile(p);
-		AddProjectile(p);
+
+	if (newQuad != p->quads.back())
+		projectileMoves.push_back({p, p->quads.back(), newQuad});
+}
+
+void CQuadField::ApplyMovedProjectiles()
+{
+	if (projectileMoves.empty())
+		return;
+
+	const auto projectileIdCmp = [](const CProjectile* a, const CProjectile* b) { return (a->id < b->id); };
+
+	// remove per old quad in a single pass over its list; ordering by id within
+	// each group keeps quad contents independent of the projectile update order
+	std::sort(projectileMoves.begin(), projectileMoves.end(), [](const ProjectileMove& a, const ProjectileMove& b) {
+		if (a.oldQuad != b.oldQuad)
+			return (a.oldQuad < b.oldQuad);
+		return (a.projectile->id < b.projectile->id);
+	});
+
+	std::vector<CProjectile*>& movedProjectiles = *tempProjectiles.GetVector();
+
+	for (size_t i = 0, j = 0, n = projectileMoves.size(); i < n; i = j) {
+		movedProjectiles.clear();
+
+		for (j = i; j < n && projectileMoves[j].oldQuad == projectileMoves[i].oldQuad; j++) {
+			assert(projectileMoves[j].projectile->quads.size() == 1);
+			assert(projectileMoves[j].projectile->quads[0] == projectileMoves[j].oldQuad);
+			movedProjectiles.push_back(projectileMoves[j].projectile);
+		}
+
+		std::vector<CProjectile*>& quadProjectiles = baseQuads[projectileMoves[i].oldQuad].projectiles;
+
+		const auto pred = [&](const CProjectile* p) {
+			return (std::binary_search(movedProjectiles.begin(), movedProjectiles.end(), p, projectileIdCmp));
+		};
+
+		quadProjectiles.erase(std::remove_if(quadProjectiles.begin(), quadProjectiles.end(), pred), quadProjectiles.end());
 	}
+
+	tempProjectiles.ReleaseVector(&movedProjectiles);
+
+	std::sort(projectileMoves.begin(), projectileMoves.end(), [](const ProjectileMove& a, const ProjectileMove& b) {
+		if (a.newQuad != b.newQuad)
+			return (a.newQuad < b.newQuad);
+		return (a.projectile->id < b.projectile->id);
+	});
+
+	for (const ProjectileMove& pm: projectileMoves) {
+		spring::VectorInsertUnique(baseQuads[pm.newQuad].projectiles, pm.projectile, false);
+		pm.projectile->quads[0] = pm.newQuad;
+	}
+
+	projectileMoves.clear();
 }
 
 void CQuadField::AddProjectile(CProjectile* p)
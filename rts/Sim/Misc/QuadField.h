@@ -144,7 +144,13 @@ needed to support dynamic resizing (not used yet)
 	void AddFeature(CFeature* feature);
 	void RemoveFeature(CFeature* feature);
 
-	void MovedProjectile(CProjectile* projectile);
+	/**
+	 * Queues <projectile> if it moved into a different quad; the
+	 * membership changes are applied by ApplyMovedProjectiles.
+	 * Until then the projectile stays listed in its old quad.
+	 */
+	void QueueMovedProjectile(CProjectile* projectile);
+	void ApplyMovedProjectiles();
 	void AddProjectile(CProjectile* projectile);
 	void RemoveProjectile(CProjectile* projectile);
 
@@ -179,6 +185,9 @@ needed to support dynamic resizing (not used yet)
 	}
 
 
+	// bumped whenever a unit or feature enters or leaves a quad
+	unsigned int GetNumSolidChanges() const { return numSolidChanges; }
+
 	int GetNumQuadsX() const { return numQuadsX; }
 	int GetNumQuadsZ() const { return numQuadsZ; }
 
@@ -199,9 +208,19 @@ private:
 	int2 WorldPosToQuadField(const float3 p) const;
 	int WorldPosToQuadFieldIdx(const float3 p) const;
 
+private:
+	struct ProjectileMove {
+		CProjectile* projectile;
+		int oldQuad;
+		int newQuad;
+	};
+
 private:
 	std::vector<Quad> baseQuads;
 
+	// projectiles that changed quads since the last ApplyMovedProjectiles
+	std::vector<ProjectileMove> projectileMoves;
+
 	// preallocated vectors for Get*Exact functions
 	ExclusiveVectors<CUnit*> tempUnits;
 	ExclusiveVectors<CFeature*> tempFeatures;
@@ -212,6 +231,8 @@ private:
 	int numQuadsX;
 	int numQuadsZ;
 
+	unsigned int numSolidChanges = 0;
+
 	int quadSizeX;
 	int quadSizeZ;
 };
@@ -45,33 +45,16 @@ private:
 	float extractorRadius;
 	float averageIncome;
 
-	bool stopMe;
-
 	// if more spots than this are found the map is considered a resource-map (eg. speed-metal), tweak as needed
 	int maxSpots;
 	int mapHeight;
 	int mapWidth;
 	int totalCells;
-	int squareRadius;
-	int doubleSquareRadius;
-	int totalResources;
-	int maxResource;
-	int tempResources;
-	int coordX;
-	int coordZ;
 	// from 0-255, the minimum percentage of resources a spot needs to have from
 	// the maximum to be saved, prevents crappier spots in between taken spaces
 	// (they are still perfectly valid and will generate resources mind you!)
 	int minIncomeForSpot;
 	int xtractorRadius;
-	int doubleRadius;
-
-	float3 bufferSpot;
-
-	std::vector<unsigned char> rexArrayA;
-	std::vector<unsigned char> rexArrayB;
-	std::vector<unsigned char> rexArrayC;
-	std::vector<int> tempAverage;
 
 	std::vector<float3> vectoredSpots;
 };
@@ -0,0 +1,168 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "ResourceSpotFinder.h"
+
+#include "System/FastMath.h"
+#include "System/Threading/ThreadPool.h"
+
+#include <algorithm>
+
+
+void CResourceSpotFinder::Init(const unsigned char* resourceMap, int _mapWidth, int _mapHeight, int extractorRadius)
+{
+	mapWidth = _mapWidth;
+	mapHeight = _mapHeight;
+	xtractorRadius = extractorRadius;
+	maxResource = 0;
+
+	xend.resize(xtractorRadius * 2 + 1);
+
+	for (int a = 0; a < xtractorRadius * 2 + 1; a++) {
+		float z = a - xtractorRadius;
+		float floatsqrradius = xtractorRadius * xtractorRadius;
+		xend[a] = int(math::sqrt(floatsqrradius - z * z));
+	}
+
+	resources.assign(resourceMap, resourceMap + mapWidth * mapHeight);
+	rowSums.resize(mapHeight * (mapWidth + 1));
+	extractorSums.resize(mapWidth * mapHeight);
+
+	for (valueTreeSize = 1; valueTreeSize < (mapWidth * mapHeight); valueTreeSize <<= 1);
+
+	valueTree.clear();
+	valueTree.resize(valueTreeSize * 2, 0);
+
+	// rows are independent, as are the per-cell sums once all rows are done
+	for_mt(0, mapHeight, [&](const int y) {
+		UpdateRowSums(y, 0);
+	});
+	for_mt(0, mapHeight, [&](const int y) {
+		for (int x = 0; x < mapWidth; x++) {
+			extractorSums[y * mapWidth + x] = GetExtractorSum(x, y);
+		}
+	});
+
+	for (const int sum: extractorSums) {
+		maxResource = std::max(maxResource, sum);
+	}
+}
+
+
+void CResourceSpotFinder::FindSpots(int maxSpots, int minValue, std::vector<Spot>& spots)
+{
+	if (maxResource <= 0)
+		return;
+
+	for_mt(0, mapHeight, [&](const int y) {
+		UpdateValues(y, 0, mapWidth - 1);
+	});
+
+	UpdateValueTree(0, mapWidth * mapHeight - 1);
+
+	for (int n = 0; n < maxSpots; n++) {
+		const int bestValue = valueTree[1];
+
+		// if the spots get too crappy, stop
+		if (bestValue < minValue)
+			break;
+
+		// descend to the first leaf holding the best value
+		int i = 1;
+
+		while (i < valueTreeSize) {
+			i = (i << 1) + (valueTree[i << 1] != bestValue);
+		}
+
+		const int spotIndex = i - valueTreeSize;
+		const int spotX = spotIndex % mapWidth;
+		const int spotZ = spotIndex / mapWidth;
+
+		spots.push_back({spotX, spotZ, bestValue});
+		ClearSpot(spotX, spotZ);
+	}
+}
+
+
+void CResourceSpotFinder::UpdateRowSums(int y, int x0)
+{
+	const unsigned char* rowResources = &resources[y * mapWidth];
+	int* rowSum = &rowSums[y * (mapWidth + 1)];
+
+	for (int x = x0; x < mapWidth; x++) {
+		rowSum[x + 1] = rowSum[x] + rowResources[x];
+	}
+}
+
+void CResourceSpotFinder::UpdateValues(int y, int x0, int x1)
+{
+	for (int x = x0; x <= x1; x++) {
+		// scale so any map will have values 0-255, no matter how much resources it has
+		valueTree[valueTreeSize + y * mapWidth + x] = extractorSums[y * mapWidth + x] * 255 / maxResource;
+	}
+}
+
+void CResourceSpotFinder::UpdateValueTree(int i0, int i1)
+{
+	for (i0 += valueTreeSize, i1 += valueTreeSize; i0 > 1; ) {
+		i0 >>= 1;
+		i1 >>= 1;
+
+		for (int i = i0; i <= i1; i++) {
+			valueTree[i] = std::max(valueTree[(i << 1)], valueTree[(i << 1) + 1]);
+		}
+	}
+}
+
+
+int CResourceSpotFinder::GetExtractorSum(int x, int y) const
+{
+	const int sy0 = std::max(y - xtractorRadius,             0);
+	const int sy1 = std::min(y + xtractorRadius, mapHeight - 1);
+
+	int sum = 0;
+
+	for (int sy = sy0, a = sy0 - (y - xtractorRadius); sy <= sy1; sy++, a++) {
+		const int* rowSum = &rowSums[sy * (mapWidth + 1)];
+
+		const int sx0 = std::max(x - xend[a],            0);
+		const int sx1 = std::min(x + xend[a], mapWidth - 1);
+
+		sum += (rowSum[sx1 + 1] - rowSum[sx0]);
+	}
+
+	return sum;
+}
+
+
+void CResourceSpotFinder::ClearSpot(int spotX, int spotZ)
+{
+	const int doubleRadius = xtractorRadius * 2;
+
+	// wipe the resources around the spot so they are not counted twice
+	for (int sy = spotZ - xtractorRadius, a = 0;  sy <= spotZ + xtractorRadius;  sy++, a++) {
+		if (sy < 0 || sy >= mapHeight)
+			continue;
+
+		const int sx0 = std::max(spotX - xend[a],            0);
+		const int sx1 = std::min(spotX + xend[a], mapWidth - 1);
+
+		std::fill(resources.begin() + sy * mapWidth + sx0, resources.begin() + sy * mapWidth + sx1 + 1, 0);
+		UpdateRowSums(sy, sx0);
+	}
+
+	// only cells within twice the radius can have a footprint overlapping the wiped area;
+	// the window is small, not worth distributing over threads
+	const int x0 = std::max(spotX - doubleRadius,             0);
+	const int x1 = std::min(spotX + doubleRadius,  mapWidth - 1);
+	const int y0 = std::max(spotZ - doubleRadius,             0);
+	const int y1 = std::min(spotZ + doubleRadius, mapHeight - 1);
+
+	for (int y = y0; y <= y1; y++) {
+		for (int x = x0; x <= x1; x++) {
+			extractorSums[y * mapWidth + x] = GetExtractorSum(x, y);
+		}
+
+		UpdateValues(y, x0, x1);
+		UpdateValueTree(y * mapWidth + x0, y * mapWidth + x1);
+	}
+}
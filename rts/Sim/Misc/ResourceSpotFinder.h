@@ -0,0 +1,75 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _RESOURCE_SPOT_FINDER_H
+#define _RESOURCE_SPOT_FINDER_H
+
+#include <vector>
+
+/**
+ * Finds the places on a resource-map where extractors (with a circular
+ * footprint) would yield the most. Used by CResourceMapAnalyzer; has no
+ * engine dependencies so it can be tested standalone.
+ *
+ * Spots are picked greedily: each step takes the first (by index) cell
+ * with the highest extractor value, wipes the resources inside its
+ * footprint and updates the values of all cells whose footprint overlaps
+ * the wiped area.
+ */
+class CResourceSpotFinder {
+public:
+	struct Spot {
+		int x;
+		int z;
+		/// extractor value at the time the spot was picked, scaled to 0-255 of GetMaxResource()
+		int value;
+	};
+
+public:
+	/**
+	 * @param resourceMap mapWidth * mapHeight cells
+	 * @param extractorRadius in resource-map cells
+	 */
+	void Init(const unsigned char* resourceMap, int mapWidth, int mapHeight, int extractorRadius);
+
+	/**
+	 * Picks up to maxSpots spots, stopping at the first one whose value is
+	 * less than minValue. May only be called once per Init.
+	 */
+	void FindSpots(int maxSpots, int minValue, std::vector<Spot>& spots);
+
+	/// highest unscaled extractor value over the unmodified map
+	int GetMaxResource() const { return maxResource; }
+
+private:
+	void UpdateRowSums(int y, int x0);
+	void UpdateValues(int y, int x0, int x1);
+	void UpdateValueTree(int i0, int i1);
+
+	int GetExtractorSum(int x, int y) const;
+
+	void ClearSpot(int x, int y);
+
+private:
+	int mapWidth = 0;
+	int mapHeight = 0;
+	int xtractorRadius = 0;
+	int maxResource = 0;
+
+	/// half-width of the extractor footprint per row offset [-radius, radius]
+	std::vector<int> xend;
+
+	std::vector<unsigned char> resources;
+	/// per-row running sums of resources, (mapWidth + 1) per row
+	std::vector<int> rowSums;
+	/// resources within the extractor footprint around each cell
+	std::vector<int> extractorSums;
+
+	/**
+	 * Max-tree over the extractor sums scaled to 0-255; the leaves (one
+	 * per cell) start at valueTreeSize, node i covers 2i and 2i+1.
+	 */
+	std::vector<unsigned char> valueTree;
+	int valueTreeSize = 0;
+};
+
+#endif // _RESOURCE_SPOT_FINDER_H
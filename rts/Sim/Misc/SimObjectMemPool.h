@@ -4,12 +4,13 @@
 #define SIMOBJECT_MEMPOOL_H
 
 #include <cassert>
+#include <cstddef> // offsetof, max_align_t
+#include <cstdint>
 #include <cstring> // memset
 #include <array>
 #include <deque>
 #include <vector>
 
-#include "System/UnorderedMap.hpp"
 #include "System/ContainerUtil.h"
 #include "System/SafeUtil.h"
 
@@ -23,25 +24,26 @@ public:
 		ctor_call_depth += 1;
 
 		T* p = nullptr;
-		uint8_t* m = nullptr;
+		Page* g = nullptr;
 
 		size_t i = 0;
 
 		if (indcs.empty()) {
+			// new pages are value-initialized and hence already zeroed
 			pages.emplace_back();
 
 			i = pages.size() - 1;
-			m = pages[curr_page_index = i].data();
-			p = new (m) T(std::forward<A>(a)...);
+			g = &pages[curr_page_index = i];
 		} else {
 			// must pop before ctor runs; objects can be created recursively
 			i = spring::VectorBackPop(indcs);
-
-			m = pages[curr_page_index = i].data();
-			p = new (m) T(std::forward<A>(a)...);
+			g = &pages[curr_page_index = i];
 		}
 
-		table.emplace(p, i);
+		g->index = i;
+		g->extent = sizeof(T);
+
+		p = new (g->data) T(std::forward<A>(a)...);
 
 		ctor_call_depth -= 1;
 		return p;
@@ -53,17 +55,21 @@ public:
 
 		dtor_call_depth += 1;
 
-		const auto iter = table.find(p);
-		const auto pair = std::pair<void*, size_t>{iter->first, iter->second};
+		Page* g = page_header(p);
 
 		spring::SafeDestruct(p);
-		std::memset(pages[pair.second].data(), 0, page_size());
+
+		// only clear the bytes the object could have dirtied; this can not be
+		// deferred to alloc since a memset right before placement-new is a dead
+		// store as far as the compiler is concerned (-flifetime-dse)
+		std::memset(g->data, 0, g->extent);
+
+		g->extent = 0;
 
 		// must push after dtor runs, since that can trigger *another* ctor call
 		// by proxy (~CUnit -> ~CObject -> DependentDied -> CommandAI::FinishCmd
 		// -> CBuilderCAI::ExecBuildCmd -> UnitLoader::LoadUnit -> CUnit e.g.)
-		indcs.push_back(pair.second);
-		table.erase(pair.first);
+		indcs.push_back(g->index);
 
 		dtor_call_depth -= 1;
 	}
@@ -73,9 +79,16 @@ public:
 
 	size_t alloc_size() const { return (pages.size() * page_size()); } // size of total number of pages added over the pool's lifetime
 	size_t freed_size() const { return (indcs.size() * page_size()); } // size of number of pages that were freed and are awaiting reuse
+	size_t live_size() const { return (alloc_size() - freed_size()); } // size of number of pages currently holding an object
 
-	bool mapped(void* p) const { return (table.find(p) != table.end()); }
-	bool alloced(void* p) const { return ((curr_page_index < pages.size()) && (&pages[curr_page_index][0] == p)); }
+	// fraction of pages holding an object; (1 - occupancy) is the fragmentation
+	float occupancy() const { return ((pages.empty())? 1.0f: (live_size() * 1.0f / alloc_size())); }
+
+	bool mapped(const void* p) const {
+		const Page* g = page_header(p);
+		return (g->index < pages.size() && &pages[g->index] == g && g->extent != 0);
+	}
+	bool alloced(const void* p) const { return ((curr_page_index < pages.size()) && (&pages[curr_page_index].data[0] == p)); }
 
 	bool ctorCall() const { return (ctor_call_depth > 0); }
 	bool dtorCall() const { return (dtor_call_depth > 0); }
@@ -84,7 +97,6 @@ public:
 	void clear() {
 		pages.clear();
 		indcs.clear();
-		table.clear();
 
 		ctor_call_depth = 0;
 		dtor_call_depth = 0;
@@ -92,15 +104,25 @@ public:
 	}
 	void reserve(size_t n) {
 		indcs.reserve(n);
-		table.reserve(n);
 	}
 
 private:
-	std::deque<std::array<uint8_t,S>> pages;
-	std::vector<size_t> indcs;
+	// intrusive header; objects live at <data> so the page (and
+	// its index) can be recovered from an object pointer without
+	// any table lookups
+	struct Page {
+		size_t index;
+		size_t extent; // sizeof(T) of the live object, 0 if free
+
+		alignas(alignof(std::max_align_t)) uint8_t data[S];
+	};
 
-	// <pointer, page index> (non-intrusive)
-	spring::unsynced_map<void*, size_t> table;
+	static Page* page_header(void* p) { return (reinterpret_cast<Page*>(reinterpret_cast<uint8_t*>(p) - offsetof(Page, data))); }
+	static const Page* page_header(const void* p) { return (reinterpret_cast<const Page*>(reinterpret_cast<const uint8_t*>(p) - offsetof(Page, data))); }
+
+private:
+	std::deque<Page> pages;
+	std::vector<size_t> indcs;
 
 	size_t ctor_call_depth = 0;
 	size_t dtor_call_depth = 0;
@@ -136,6 +158,8 @@ public:
 			p = new (m) T(std::forward<A>(a)...);
 		}
 
+		extents[i] = sizeof(T);
+
 		ctor_call_depth -= 1;
 		return p;
 	}
@@ -143,16 +167,19 @@ public:
 	template<typename T> void free(T*& t) {
 		uint8_t* m = reinterpret_cast<uint8_t*>(t);
 
+		const size_t i = base_offset(m) / page_size();
+
 		assert(can_free());
 		assert(mapped(t));
 
 		dtor_call_depth += 1;
 
 		spring::SafeDestruct(t);
-		std::memset(m, 0, page_size());
+		std::memset(m, 0, extents[i]);
 
 		// mark page as free
-		indcs[free_page_count++] = base_offset(m) / page_size();
+		indcs[free_page_count++] = i;
+		extents[i] = 0;
 
 		dtor_call_depth -= 1;
 	}
@@ -163,7 +190,11 @@ public:
 
 	size_t alloc_size() const { return (used_page_count * page_size()); } // size of total number of pages added over the pool's lifetime
 	size_t freed_size() const { return (free_page_count * page_size()); } // size of number of pages that were freed and are awaiting reuse
+	size_t live_size() const { return (alloc_size() - freed_size()); } // size of number of pages currently holding an object
 	size_t total_size() const { return (num_pages() * page_size()); }
+
+	// fraction of touched pages holding an object; (1 - occupancy) is the fragmentation
+	float occupancy() const { return ((used_page_count == 0)? 1.0f: (live_size() * 1.0f / alloc_size())); }
 	size_t base_offset(const void* p) const { return (reinterpret_cast<const uint8_t*>(p) - reinterpret_cast<const uint8_t*>(&pages[0][0])); }
 
 	bool mapped(const void* p) const { return (((base_offset(p) / page_size()) < total_size()) && ((base_offset(p) % page_size()) == 0)); }
@@ -179,7 +210,8 @@ public:
 	void reserve(size_t) {} // no-op
 	void clear() {
 		std::memset(pages.data(), 0, total_size());
-		std::memset(indcs.data(), 0, num_pages());
+		std::memset(indcs.data(), 0, num_pages() * sizeof(size_t));
+		std::memset(extents.data(), 0, num_pages() * sizeof(size_t));
 
 		used_page_count = 0;
 		free_page_count = 0;
@@ -192,6 +224,7 @@ public:
 private:
 	std::array<std::array<uint8_t, S>, N> pages;
 	std::array<size_t, N> indcs;
+	std::array<size_t, N> extents; // sizeof(T) of the live object per page
 
 	size_t used_page_count = 0;
 	size_t free_page_count = 0; // indcs[fpc-1] is the last recycled page
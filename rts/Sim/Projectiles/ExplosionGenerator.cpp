@@ -4,6 +4,8 @@
 #include <stdexcept>
 #include <cassert>
 #include <cinttypes>
+#include <cstring>
+#include <algorithm>
 
 #include "ExplosionGenerator.h"
 #include "ExpGenSpawner.h" //!!
@@ -54,7 +56,9 @@ CR_REG_METADATA_SUB(CCustomExplosionGenerator, ProjectileSpawnInfo, (
 	CR_MEMBER(spawnableID),
 	CR_MEMBER(code),
 	CR_MEMBER(count),
-	CR_MEMBER(flags)
+	CR_MEMBER(flags),
+	CR_IGNORED(program),
+	CR_POSTLOAD(PostLoad)
 ))
 
 CR_BIND(GroundFlashInfo, )
@@ -602,127 +606,222 @@ bool CStdExplosionGenerator::Explosion(
 
 
 
-void CCustomExplosionGenerator::ExecuteExplosionCode(const char* code, float damage, char* instance, int spawnIndex, const float3& dir)
+void CCustomExplosionGenerator::ProjectileSpawnInfo::PostLoad()
+{
+	LowerExplosionCode(this);
+}
+
+
+// ops that only depend on <val> and their own argument
+static inline bool IsConstantOp(int op)
+{
+	switch (op) {
+		case CCustomExplosionGenerator::OP_ADD:
+		case CCustomExplosionGenerator::OP_SAWTOOTH:
+		case CCustomExplosionGenerator::OP_DISCRETE:
+		case CCustomExplosionGenerator::OP_SINE:
+		case CCustomExplosionGenerator::OP_POW: {
+			return true;
+		} break;
+		default: {
+		} break;
+	}
+
+	return false;
+}
+
+static inline float ExecuteConstantOp(int op, float val, float arg)
+{
+	switch (op) {
+		case CCustomExplosionGenerator::OP_ADD     : { return (val + arg); } break;
+		// this translates to modulo except it works with floats
+		case CCustomExplosionGenerator::OP_SAWTOOTH: { return (val - arg * math::floor(val / arg)); } break;
+		case CCustomExplosionGenerator::OP_DISCRETE: { return (arg * math::floor(spring::SafeDivide(val, arg))); } break;
+		case CCustomExplosionGenerator::OP_SINE    : { return (arg * math::sin(val)); } break;
+		case CCustomExplosionGenerator::OP_POW     : { return (math::pow(val, arg)); } break;
+		default: {
+			assert(false);
+		} break;
+	}
+
+	return val;
+}
+
+template<typename T> static inline T ReadExplosionCode(const char*& code)
+{
+	T v;
+	std::memcpy(&v, code, sizeof(T));
+	code += sizeof(T);
+	return v;
+}
+
+
+void CCustomExplosionGenerator::LowerExplosionCode(ProjectileSpawnInfo* psi)
+{
+	// decode the byte-code once so spawning does not have to, and fold each
+	// property whose value does not depend on damage, index, rand or buffer
+	// into a single store; properties are separated by their final STORE op
+	// and <val> is always zero at the start of one
+	std::vector<SpawnOp>& program = psi->program;
+	std::vector<SpawnOp> segment;
+
+	program.clear();
+	program.reserve(psi->code.size() / 4);
+
+	const char* code = psi->code.data();
+	const char* cend = code + psi->code.size();
+
+	void* ptr = nullptr;
+
+	while (code < cend) {
+		SpawnOp sop;
+
+		sop.op = *(code++);
+		sop.size = 0;
+		sop.offset = 0;
+		sop.arg.p = nullptr;
+
+		switch (sop.op) {
+			case OP_END: {
+				code = cend;
+			} break;
+
+			case OP_STOREI:
+			case OP_STOREF: {
+				sop.size   = ReadExplosionCode<std::uint8_t >(code);
+				sop.offset = ReadExplosionCode<std::uint16_t>(code);
+
+				const bool isConst = std::find_if(segment.begin(), segment.end(), [](const SpawnOp& o) { return !IsConstantOp(o.op); }) == segment.end();
+
+				if (isConst) {
+					float val = 0.0f;
+
+					for (const SpawnOp& o: segment) {
+						val = ExecuteConstantOp(o.op, val, o.arg.f);
+					}
+
+					if (sop.op == OP_STOREI) {
+						sop.op = OP_CONSTI;
+						sop.arg.i = (int) val;
+					} else {
+						sop.op = OP_CONSTF;
+						sop.arg.f = val;
+					}
+				} else {
+					program.insert(program.end(), segment.begin(), segment.end());
+				}
+
+				program.push_back(sop);
+				segment.clear();
+			} break;
+
+			case OP_LOADP: {
+				ptr = ReadExplosionCode<void*>(code);
+			} break;
+			case OP_STOREP: {
+				// fuse with the preceding LOADP
+				sop.offset = ReadExplosionCode<std::uint16_t>(code);
+				sop.arg.p = ptr;
+				program.push_back(sop);
+				ptr = nullptr;
+			} break;
+			case OP_DIR: {
+				// does not touch <val>, so can not interfere with an open segment
+				sop.offset = ReadExplosionCode<std::uint16_t>(code);
+				program.push_back(sop);
+			} break;
+
+			case OP_YANK:
+			case OP_MULTIPLY:
+			case OP_ADDBUFF:
+			case OP_POWBUFF: {
+				sop.arg.i = ReadExplosionCode<int>(code);
+				segment.push_back(sop);
+			} break;
+
+			default: {
+				sop.arg.f = ReadExplosionCode<float>(code);
+				segment.push_back(sop);
+			} break;
+		}
+	}
+}
+
+
+void CCustomExplosionGenerator::ExecuteExplosionCode(const SpawnOp* ops, size_t numOps, float damage, char* instance, int spawnIndex, const float3& dir)
 {
 	float val = 0.0f;
-	void* ptr = NULL;
 	float buffer[16];
 
 	std::memset(&buffer[0], 0, 16 * sizeof(float));
 
-	for (;;) {
-		switch (*(code++)) {
-			case OP_END: {
-				return;
-			}
+	for (const SpawnOp* op = ops; op != (ops + numOps); ++op) {
+		switch (op->op) {
 			case OP_STOREI: {
-				std::uint8_t  size   = *(std::uint8_t*)  code; code++;
-				std::uint16_t offset = *(std::uint16_t*) code; code += 2;
-				switch (size) {
-					case 1: { *(std::int8_t*)  (instance + offset) = (int) val; } break;
-					case 2: { *(std::int16_t*) (instance + offset) = (int) val; } break;
-					case 4: { *(std::int32_t*) (instance + offset) = (int) val; } break;
-					case 8: { *(std::int64_t*) (instance + offset) = (int) val; } break;
+				switch (op->size) {
+					case 1: { *(std::int8_t*)  (instance + op->offset) = (int) val; } break;
+					case 2: { *(std::int16_t*) (instance + op->offset) = (int) val; } break;
+					case 4: { *(std::int32_t*) (instance + op->offset) = (int) val; } break;
+					case 8: { *(std::int64_t*) (instance + op->offset) = (int) val; } break;
 					default: { /*no op*/ } break;
 				}
 				val = 0.0f;
-				break;
-			}
+			} break;
 			case OP_STOREF: {
-				std::uint8_t  size   = *(std::uint8_t*)  code; code++;
-				std::uint16_t offset = *(std::uint16_t*) code; code += 2;
-				switch (size) {
-					case 4: { *(float*)  (instance + offset) = val; } break;
-					case 8: { *(double*) (instance + offset) = val; } break;
+				switch (op->size) {
+					case 4: { *(float*)  (instance + op->offset) = val; } break;
+					case 8: { *(double*) (instance + op->offset) = val; } break;
 					default: { /*no op*/ } break;
 				}
 				val = 0.0f;
-				break;
-			}
-			case OP_ADD: {
-				val += *(float*) code;
-				code += 4;
-				break;
-			}
+			} break;
+			case OP_CONSTI: {
+				switch (op->size) {
+					case 1: { *(std::int8_t*)  (instance + op->offset) = op->arg.i; } break;
+					case 2: { *(std::int16_t*) (instance + op->offset) = op->arg.i; } break;
+					case 4: { *(std::int32_t*) (instance + op->offset) = op->arg.i; } break;
+					case 8: { *(std::int64_t*) (instance + op->offset) = op->arg.i; } break;
+					default: { /*no op*/ } break;
+				}
+			} break;
+			case OP_CONSTF: {
+				switch (op->size) {
+					case 4: { *(float*)  (instance + op->offset) = op->arg.f; } break;
+					case 8: { *(double*) (instance + op->offset) = op->arg.f; } break;
+					default: { /*no op*/ } break;
+				}
+			} break;
 			case OP_RAND: {
-				val += guRNG.NextFloat() * (*(float*) code);
-				code += 4;
-				break;
-			}
+				val += guRNG.NextFloat() * op->arg.f;
+			} break;
 			case OP_DAMAGE: {
-				val += damage * (*(float*) code);
-				code += 4;
-				break;
-			}
+				val += damage * op->arg.f;
+			} break;
 			case OP_INDEX: {
-				val += spawnIndex * (*(float*) code);
-				code += 4;
-				break;
-			}
-			case OP_LOADP: {
-				ptr = *(void**) code;
-				code += sizeof(void*);
-				break;
-			}
+				val += spawnIndex * op->arg.f;
+			} break;
 			case OP_STOREP: {
-				std::uint16_t offset = *(std::uint16_t*) code;
-				code += 2;
-				*(void**) (instance + offset) = ptr;
-				ptr = NULL;
-				break;
-			}
+				*(void**) (instance + op->offset) = op->arg.p;
+			} break;
 			case OP_DIR: {
-				std::uint16_t offset = *(std::uint16_t*) code;
-				code += 2;
-				*reinterpret_cast<float3*>(instance + offset) = dir;
-				break;
-			}
-			case OP_SAWTOOTH: {
-				// this translates to modulo except it works with floats
-				val -= (*(float*) code) * math::floor(val / (*(float*) code));
-				code += 4;
-				break;
-			}
-			case OP_DISCRETE: {
-				val = (*(float*) code) * math::floor(spring::SafeDivide(val, (*(float*) code)));
-				code += 4;
-				break;
-			}
-			case OP_SINE: {
-				val = (*(float*) code) * math::sin(val);
-				code += 4;
-				break;
-			}
+				*reinterpret_cast<float3*>(instance + op->offset) = dir;
+			} break;
 			case OP_YANK: {
-				buffer[(*(int*) code)] = val;
+				buffer[op->arg.i] = val;
 				val = 0;
-				code += 4;
-				break;
-			}
+			} break;
 			case OP_MULTIPLY: {
-				val *= buffer[(*(int*) code)];
-				code += 4;
-				break;
-			}
+				val *= buffer[op->arg.i];
+			} break;
 			case OP_ADDBUFF: {
-				val += buffer[(*(int*) code)];
-				code += 4;
-				break;
-			}
-			case OP_POW: {
-				val = math::pow(val, (*(float*) code));
-				code += 4;
-				break;
-			}
+				val += buffer[op->arg.i];
+			} break;
 			case OP_POWBUFF: {
-				val = math::pow(val, buffer[(*(int*) code)]);
-				code += 4;
-				break;
-			}
+				val = math::pow(val, buffer[op->arg.i]);
+			} break;
 			default: {
-				assert(false);
-				break;
-			}
+				val = ExecuteConstantOp(op->op, val, op->arg.f);
+			} break;
 		}
 	}
 }
@@ -919,6 +1018,8 @@ bool CCustomExplosionGenerator::Load(CExplosionGeneratorHandler* handler, const
 		psi.code.resize(code.size());
 		copy(code.begin(), code.end(), psi.code.begin());
 
+		LowerExplosionCode(&psi);
+
 		expGenParams.projectiles.push_back(psi);
 	}
 
@@ -981,9 +1082,12 @@ bool CCustomExplosionGenerator::Explosion(
 		if (projectileHandler->GetParticleSaturation() > 1.0f)
 			break;
 
+		const SpawnOp* ops = psi.program.data();
+		const size_t numOps = psi.program.size();
+
 		for (unsigned int c = 0; c < psi.count; c++) {
 			CExpGenSpawnable* projectile = CExpGenSpawnable::CreateSpawnable(psi.spawnableID);
-			ExecuteExplosionCode(&psi.code[0], damage, (char*) projectile, c, dir);
+			ExecuteExplosionCode(ops, numOps, damage, (char*) projectile, c, dir);
 			projectile->Init(owner, pos);
 		}
 	}
@@ -3,6 +3,7 @@
 #ifndef EXPLOSION_GENERATOR_H
 #define EXPLOSION_GENERATOR_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -146,6 +147,19 @@ class CCustomExplosionGenerator: public IExplosionGenerator
 	CR_DECLARE_SUB(ExpGenParams)
 
 protected:
+	/// one decoded instruction of a lowered (see LowerExplosionCode) program
+	struct SpawnOp {
+		std::uint8_t  op;     // OP_*
+		std::uint8_t  size;   // member width for stores
+		std::uint16_t offset; // member offset for stores
+
+		union {
+			float f;
+			int   i;
+			void* p;
+		} arg;
+	};
+
 	struct ProjectileSpawnInfo {
 		CR_DECLARE_STRUCT(ProjectileSpawnInfo)
 
@@ -157,14 +171,19 @@ protected:
 		ProjectileSpawnInfo(const ProjectileSpawnInfo& psi)
 			: spawnableID(psi.spawnableID)
 			, code(psi.code)
+			, program(psi.program)
 			, count(psi.count)
 			, flags(psi.flags)
 		{}
 
+		void PostLoad();
+
 		unsigned int spawnableID;
 
 		/// parsed explosion script code
 		std::vector<char> code;
+		/// <code> lowered to typed ops, with constant properties folded
+		std::vector<SpawnOp> program;
 
 		/// number of projectiles spawned of this type
 		unsigned int count;
@@ -222,11 +241,16 @@ public:
 		OP_ADDBUFF  = 16, // Adds buffer value
 		OP_POW      = 17, // Power with code as exponent
 		OP_POWBUFF  = 18, // Power with buffer as exponent
+
+		// only present in lowered programs
+		OP_CONSTI   = 32, // store a load-time folded int
+		OP_CONSTF   = 33, // store a load-time folded float
 	};
 
 private:
 	void ParseExplosionCode(ProjectileSpawnInfo* psi, const std::string& script, SExpGenSpawnableMemberInfo& memberInfo, std::string& code);
-	void ExecuteExplosionCode(const char* code, float damage, char* instance, int spawnIndex, const float3& dir);
+	static void LowerExplosionCode(ProjectileSpawnInfo* psi);
+	static void ExecuteExplosionCode(const SpawnOp* ops, size_t numOps, float damage, char* instance, int spawnIndex, const float3& dir);
 
 protected:
 	ExpGenParams expGenParams;
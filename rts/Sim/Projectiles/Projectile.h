@@ -42,6 +42,10 @@ public:
 	//Not inheritable - used for removing a projectile from Lua.
 	void Delete();
 	virtual void Update();
+	// true if Update() only touches this projectile's own state (no spawning,
+	// events or writes to other objects); unsynced projectiles for which this
+	// holds are updated in parallel by the ProjectileHandler
+	virtual bool HasLocalUpdate() const { return false; }
 	virtual void Init(const CUnit* owner, const float3& offset) override;
 
 	virtual void Draw(CVertexArray* va) {}
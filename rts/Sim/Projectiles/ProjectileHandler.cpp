@@ -17,7 +17,6 @@
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Rendering/Env/Particles/Classes/FlyingPiece.h"
-#include "Rendering/Env/Particles/Classes/NanoProjectile.h"
 #include "Sim/Projectiles/WeaponProjectiles/WeaponProjectile.h"
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitDef.h"
@@ -28,6 +27,7 @@
 #include "System/EventHandler.h"
 #include "System/Log/ILog.h"
 #include "System/TimeProfiler.h"
+#include "System/Threading/ThreadPool.h"
 #include "System/creg/STL_Deque.h"
 
 
@@ -35,6 +35,10 @@
 #define NORMAL_NANO_PRIO 0.95f
 #define HIGH_NANO_PRIO 1.0f
 
+// unsynced particle counts below which a parallel update is not worth the overhead
+#define MT_PARTICLE_UPDATE_MIN   1024
+#define MT_PARTICLE_UPDATE_CHUNK  256
+
 
 using namespace std;
 
@@ -47,12 +51,14 @@ CR_REG_METADATA(CProjectileHandler, (
 	CR_MEMBER(syncedProjectiles),
 	CR_MEMBER(unsyncedProjectiles),
 	CR_MEMBER_UN(flyingPieces),
+	CR_MEMBER_UN(nanoParticles),
 	CR_MEMBER_UN(groundFlashes),
 	CR_MEMBER_UN(resortFlyingPieces),
 
 	CR_MEMBER(maxParticles),
 	CR_MEMBER(maxNanoParticles),
 	CR_MEMBER(currentNanoParticles),
+	CR_MEMBER_UN(numNanoParticles),
 	CR_MEMBER_UN(lastCurrentParticles),
 	CR_MEMBER_UN(lastSyncedProjectilesCount),
 	CR_MEMBER_UN(lastUnsyncedProjectilesCount),
@@ -74,6 +80,7 @@ CProjectileHandler* projectileHandler = nullptr;
 
 CProjectileHandler::CProjectileHandler()
 : currentNanoParticles(0)
+, numNanoParticles(0)
 , lastCurrentParticles(0)
 , lastSyncedProjectilesCount(0)
 , lastUnsyncedProjectilesCount(0)
@@ -142,6 +149,11 @@ CProjectileHandler::~CProjectileHandler()
 		}
 	}
 
+	{
+		nanoParticles.clear();
+		numNanoParticles = 0;
+	}
+
 	freeSyncedIDs.clear();
 	freeUnsyncedIDs.clear();
 
@@ -227,18 +239,49 @@ void CProjectileHandler::UpdateProjectileContainer(ProjectileContainer& pc, bool
 
 	SCOPED_TIMER("Sim::Projectiles::Update");
 
+	// unsynced particles with a self-contained Update are processed in parallel
+	// first; the serial loop below handles everything that can spawn new (also
+	// unsynced) projectiles, plus any projectiles appended to <pc> meanwhile
+	const size_t numLocalUpdates = (!synced && pc.size() >= MT_PARTICLE_UPDATE_MIN)? pc.size(): 0;
+
+	if (numLocalUpdates > 0) {
+		SCOPED_TIMER("Sim::Projectiles::UpdateUnsyncedMT");
+
+		for_mt(0, (numLocalUpdates + MT_PARTICLE_UPDATE_CHUNK - 1) / MT_PARTICLE_UPDATE_CHUNK, [&](const int k) {
+			const size_t i0 = k * MT_PARTICLE_UPDATE_CHUNK;
+			const size_t i1 = std::min(i0 + MT_PARTICLE_UPDATE_CHUNK, numLocalUpdates);
+
+			for (size_t i = i0; i < i1; ++i) {
+				CProjectile* p = pc[i];
+
+				if (!p->HasLocalUpdate())
+					continue;
+
+				MAPPOS_SANITY_CHECK(p->pos);
+				p->Update();
+				MAPPOS_SANITY_CHECK(p->pos);
+			}
+		});
+	}
+
 	// WARNING: same as above but for p->Update()
 	for (size_t i = 0; i < pc.size(); ++i) {
 		CProjectile* p = pc[i];
 		assert(p != nullptr);
 
+		if (i < numLocalUpdates && p->HasLocalUpdate())
+			continue;
+
 		MAPPOS_SANITY_CHECK(p->pos);
 
 		p->Update();
-		quadField->MovedProjectile(p);
+		quadField->QueueMovedProjectile(p);
 
 		MAPPOS_SANITY_CHECK(p->pos);
 	}
+
+	// quad changes are batched; collision checks only run after this
+	quadField->ApplyMovedProjectiles();
 }
 
 
@@ -301,6 +344,16 @@ static void UPDATE_REF_CONTAINER(T& cont) {
 }
 
 
+void CProjectileHandler::UpdateNanoParticles()
+{
+	for (NanoParticles& np: nanoParticles) {
+		numNanoParticles -= np.Update(gs->frameNum);
+	}
+
+	assert(numNanoParticles >= 0);
+}
+
+
 void CProjectileHandler::Update()
 {
 	{
@@ -324,6 +377,8 @@ void CProjectileHandler::Update()
 				std::stable_sort(fpc.begin(), fpc.end());
 			}
 		}
+
+		UpdateNanoParticles();
 	}
 
 	// precache part of particles count calculation that else becomes very heavy
@@ -655,7 +710,7 @@ void CProjectileHandler::AddNanoParticle(
 {
 	const float priority = highPriority? HIGH_NANO_PRIO: NORMAL_NANO_PRIO;
 
-	if (currentNanoParticles >= (maxNanoParticles * priority))
+	if ((currentNanoParticles + numNanoParticles) >= (maxNanoParticles * priority))
 		return;
 	if (!unitDef->showNanoSpray)
 		return;
@@ -674,7 +729,8 @@ void CProjectileHandler::AddNanoParticle(
 		SColor(tColor[0], tColor[1], tColor[2], uint8_t(20)),
 	};
 
-	projMemPool.alloc<CNanoProjectile>(startPos, dif, int(l), colors[globalRendering->teamNanospray]);
+	GetTeamNanoParticles(teamNum).Add(startPos, dif, gs->frameNum + int(l), colors[globalRendering->teamNanospray]);
+	numNanoParticles += 1;
 }
 
 void CProjectileHandler::AddNanoParticle(
@@ -688,7 +744,7 @@ void CProjectileHandler::AddNanoParticle(
 {
 	const float priority = highPriority? HIGH_NANO_PRIO: NORMAL_NANO_PRIO;
 
-	if (currentNanoParticles >= (maxNanoParticles * priority))
+	if ((currentNanoParticles + numNanoParticles) >= (maxNanoParticles * priority))
 		return;
 	if (!unitDef->showNanoSpray)
 		return;
@@ -707,11 +763,26 @@ void CProjectileHandler::AddNanoParticle(
 		SColor(tColor[0], tColor[1], tColor[2], uint8_t(20)),
 	};
 
+	NanoParticles& np = GetTeamNanoParticles(teamNum);
+
 	if (!inverse) {
-		projMemPool.alloc<CNanoProjectile>(startPos, (dif + error) * 3, int(l / 3), colors[globalRendering->teamNanospray]);
+		np.Add(startPos, (dif + error) * 3, gs->frameNum + int(l / 3), colors[globalRendering->teamNanospray]);
 	} else {
-		projMemPool.alloc<CNanoProjectile>(startPos + (dif + error) * l, -(dif + error) * 3, int(l / 3), colors[globalRendering->teamNanospray]);
+		np.Add(startPos + (dif + error) * l, -(dif + error) * 3, gs->frameNum + int(l / 3), colors[globalRendering->teamNanospray]);
 	}
+
+	numNanoParticles += 1;
+}
+
+NanoParticles& CProjectileHandler::GetTeamNanoParticles(int teamNum)
+{
+	assert(teamHandler->IsValidTeam(teamNum));
+
+	// grown on demand, independent of when teams are set up
+	if (teamNum >= int(nanoParticles.size()))
+		nanoParticles.resize(teamNum + 1);
+
+	return nanoParticles[teamNum];
 }
 
 
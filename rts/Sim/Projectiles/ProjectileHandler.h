@@ -7,6 +7,7 @@
 #include <deque>
 #include <vector>
 #include "Rendering/Models/3DModel.h"
+#include "Rendering/Env/Particles/Classes/NanoParticles.h"
 #include "Sim/Projectiles/ProjectileFunctors.h"
 #include "System/float3.h"
 
@@ -26,6 +27,7 @@ typedef std::vector<CProjectile*> ProjectileMap;
 typedef std::vector<CProjectile*> ProjectileContainer; // <unsorted>
 typedef std::vector<CGroundFlash*> GroundFlashContainer;
 typedef std::vector<FlyingPiece> FlyingPieceContainer;
+typedef std::vector<NanoParticles> NanoParticleContainer;
 
 
 class CProjectileHandler
@@ -74,7 +76,8 @@ public:
 public:
 	int maxParticles;              // different effects should start to cut down on unnececary(unsynced) particles when this number is reached
 	int maxNanoParticles;
-	int currentNanoParticles;
+	int currentNanoParticles;      // number of CNanoProjectile's (CEG-spawned)
+	int numNanoParticles;          // number of particles in nanoParticles
 
 	// these vars are used to precache parts of GetCurrentParticles() calculations
 	int lastCurrentParticles;
@@ -85,12 +88,17 @@ public:
 	std::array<                bool, MODELTYPE_OTHER> resortFlyingPieces;
 	std::array<FlyingPieceContainer, MODELTYPE_OTHER> flyingPieces;  // unsynced
 
+	NanoParticleContainer nanoParticles;      // unsynced, indexed by team
+
 	ProjectileContainer syncedProjectiles;    // contains only projectiles that can change simulation state
 	ProjectileContainer unsyncedProjectiles;  // contains only projectiles that cannot change simulation state
 	GroundFlashContainer groundFlashes;       // unsynced
 
 private:
 	void UpdateProjectileContainer(ProjectileContainer&, bool);
+	void UpdateNanoParticles();
+
+	NanoParticles& GetTeamNanoParticles(int teamNum);
 
 	std::deque<int> freeSyncedIDs;            // available synced (weapon, piece) projectile ID's
 	std::deque<int> freeUnsyncedIDs;          // available unsynced projectile ID's
@@ -70,7 +70,10 @@ CR_REG_METADATA(CMobileCAI, (
 
 	CR_MEMBER(cancelDistance),
 	CR_MEMBER(slowGuard),
-	CR_MEMBER(moveDir)
+	CR_MEMBER(moveDir),
+
+	CR_IGNORED(weaponTargetCategories),
+	CR_IGNORED(numCachedWeapons)
 ))
 
 CMobileCAI::CMobileCAI():
@@ -89,7 +92,9 @@ CMobileCAI::CMobileCAI():
 	cancelDistance(1024),
 	lastCloseInTry(-1),
 	slowGuard(false),
-	moveDir(gsRNG.NextFloat() > 0.5f)
+	moveDir(gsRNG.NextFloat() > 0.5f),
+	weaponTargetCategories(0),
+	numCachedWeapons(0)
 {}
 
 
@@ -109,7 +114,9 @@ CMobileCAI::CMobileCAI(CUnit* owner):
 	cancelDistance(1024),
 	lastCloseInTry(-1),
 	slowGuard(false),
-	moveDir(gsRNG.NextFloat() > 0.5f)
+	moveDir(gsRNG.NextFloat() > 0.5f),
+	weaponTargetCategories(0),
+	numCachedWeapons(0)
 {
 	CalculateCancelDistance();
 
@@ -584,6 +591,10 @@ bool CMobileCAI::IsValidTarget(const CUnit* enemy) const {
 	if (owner->weapons.empty())
 		return false;
 
+	// no weapon would pass the category test in CWeapon::TestTarget
+	if ((enemy->category & GetWeaponTargetCategories()) == 0)
+		return false;
+
 	// test if any weapon can target the enemy unit
 	for (CWeapon* w: owner->weapons) {
 		if (w->TestTarget(enemy->pos, SWeaponTarget(enemy)) &&
@@ -595,6 +606,21 @@ bool CMobileCAI::IsValidTarget(const CUnit* enemy) const {
 	return false;
 }
 
+unsigned int CMobileCAI::GetWeaponTargetCategories() const
+{
+	// weapons are only (re)loaded wholesale, so a changed count is enough
+	if (numCachedWeapons != owner->weapons.size()) {
+		numCachedWeapons = owner->weapons.size();
+		weaponTargetCategories = 0;
+
+		for (const CWeapon* w: owner->weapons) {
+			weaponTargetCategories |= w->onlyTargetCategory;
+		}
+	}
+
+	return weaponTargetCategories;
+}
+
 /**
 * @brief Executes the guard command c
 */
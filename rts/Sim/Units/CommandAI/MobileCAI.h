@@ -109,6 +109,17 @@ protected:
 private:
 	bool MobileAutoGenerateTarget();
 	bool GenerateAttackCmd();
+
+	unsigned int GetWeaponTargetCategories() const;
+
+private:
+	/**
+	 * Union of the onlyTargetCategory masks of all owner weapons, lets
+	 * IsValidTarget reject enemies without testing each weapon. Derived
+	 * state, rebuilt whenever the number of weapons has changed.
+	 */
+	mutable unsigned int weaponTargetCategories;
+	mutable unsigned int numCachedWeapons;
 };
 
 #endif /* MOBILE_CAI_H */
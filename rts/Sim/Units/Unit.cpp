@@ -289,21 +289,26 @@ void CUnit::PreInit(const UnitLoadParams& params)
 	{
 		const FeatureDef* wreckFeatureDef = featureDefHandler->GetFeatureDef(unitDef->wreckName);
 
-		if (wreckFeatureDef != nullptr) {
+		if (wreckFeatureDef != nullptr)
 			featureDefID = wreckFeatureDef->id;
 
+		// the same for every unit of this type, no need to repeat the lookups
+		if (!unitDef->preloadedDependentModels) {
 			while (wreckFeatureDef != nullptr) {
 				wreckFeatureDef->PreloadModel();
 				wreckFeatureDef = featureDefHandler->GetFeatureDefByID(wreckFeatureDef->deathFeatureDefID);
 			}
+
+			for (const auto it: unitDef->buildOptions) {
+				const UnitDef* ud = unitDefHandler->GetUnitDefByName(it.second);
+				if (ud == nullptr)
+					continue;
+				ud->PreloadModel();
+			}
+
+			unitDef->preloadedDependentModels = true;
 		}
 	}
-	for (const auto it: unitDef->buildOptions) {
-		const UnitDef* ud = unitDefHandler->GetUnitDefByName(it.second);
-		if (ud == nullptr)
-			continue;
-		ud->PreloadModel();
-	}
 
 	team = params.teamID;
 	allyteam = teamHandler->AllyTeam(team);
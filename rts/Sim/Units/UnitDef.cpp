@@ -143,6 +143,7 @@ UnitDef::UnitDef()
 	, deathExpWeaponDef(NULL)
 	, selfdExpWeaponDef(NULL)
 	, buildPic(NULL)
+	, preloadedDependentModels(false)
 	, selfDCountdown(0)
 	, builder(false)
 	, activateWhenBuilt(false)
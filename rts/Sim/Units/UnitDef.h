@@ -218,6 +218,9 @@ public:
 	mutable UnitDefImage* buildPic;
 	mutable icon::CIcon iconType;
 
+	/// set once the models of wrecks and build options were queued for preloading
+	mutable bool preloadedDependentModels;
+
 	int selfDCountdown;
 
 	bool builder;
@@ -109,6 +109,9 @@ CUnitHandler::CUnitHandler():
 
 CUnitHandler::~CUnitHandler()
 {
+	CWeapon::lofCacheHits = 0;
+	CWeapon::lofCacheMisses = 0;
+
 	for (CUnit* u: activeUnits) {
 		// ~CUnit dereferences featureHandler which is destroyed already
 		u->delayedWreckLevel = -1;
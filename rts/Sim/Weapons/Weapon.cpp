@@ -12,6 +12,7 @@
 #include "Sim/Misc/CollisionVolume.h"
 #include "Sim/Misc/InterceptHandler.h"
 #include "Sim/Misc/ModInfo.h"
+#include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/MoveTypes/AAirMoveType.h"
 #include "Sim/Projectiles/ProjectileHandler.h"
@@ -30,6 +31,25 @@
 #include "System/Sound/ISoundChannels.h"
 #include "System/Log/ILog.h"
 
+// line-of-fire results are only reused within the frame they were traced
+// in, while no solid object was added to, removed from or moved between
+// quads since, and while neither end of the ray moved beyond the tolerance
+static constexpr float LOF_CACHE_TOLERANCE = SQUARE_SIZE * 0.5f;
+
+size_t CWeapon::lofCacheHits = 0;
+size_t CWeapon::lofCacheMisses = 0;
+
+
+CR_BIND(CWeapon::LineOfFireCacheEntry, )
+CR_REG_METADATA_SUB(CWeapon, LineOfFireCacheEntry, (
+	CR_MEMBER(frame),
+	CR_MEMBER(unitID),
+	CR_MEMBER(numSolidChanges),
+	CR_MEMBER(srcPos),
+	CR_MEMBER(tgtPos),
+	CR_MEMBER(result)
+))
+
 CR_BIND_DERIVED_POOL(CWeapon, CObject, , weaponMemPool.alloc, weaponMemPool.free)
 CR_REG_METADATA(CWeapon, (
 	CR_MEMBER(owner),
@@ -94,7 +114,8 @@ CR_REG_METADATA(CWeapon, (
 	CR_MEMBER(currentTarget),
 	CR_MEMBER(currentTargetPos),
 
-	CR_MEMBER(incomingProjectileIDs)
+	CR_MEMBER(incomingProjectileIDs),
+	CR_MEMBER(lofCache)
 ))
 
 
@@ -164,6 +185,10 @@ CWeapon::CWeapon(CUnit* owner, const WeaponDef* def):
 	fireSoundVolume(0)
 {
 	assert(weaponMemPool.alloced(this));
+
+	for (LineOfFireCacheEntry& e: lofCache) {
+		e = {-1, -1, 0, ZeroVector, ZeroVector, false};
+	}
 }
 
 
@@ -399,7 +424,7 @@ void CWeapon::UpdateFire()
 	if (!CanFire(false, false, false))
 		return;
 
-	if (!TryTarget(currentTargetPos, currentTarget, true))
+	if (!TryTarget(currentTargetPos, currentTarget, true, true))
 		return;
 
 	// pre-check if we got enough resources (so CobBlockShot gets only called when really possible to shoot)
@@ -584,7 +609,7 @@ bool CWeapon::AllowWeaponAutoTarget() const
 	if (avoidTarget)   { return true; }
 
 	if (currentTarget.type == Target_Unit) {
-		if (!TryTarget(SWeaponTarget(currentTarget.unit, currentTarget.isUserTarget))) {
+		if (!TryTargetCached(SWeaponTarget(currentTarget.unit, currentTarget.isUserTarget))) {
 			// if we have a user-target (ie. a user attack order)
 			// then only allow generating opportunity targets iff
 			// it is not possible to hit the user's chosen unit
@@ -648,7 +673,7 @@ bool CWeapon::AutoTarget()
 		if (isBadTarget && (badTargetUnit != nullptr))
 			continue;
 
-		if (!TryTarget(SWeaponTarget(unit)))
+		if (!TryTargetCached(SWeaponTarget(unit)))
 			continue;
 
 		if (unit->IsNeutral() && (owner->fireState < FIRESTATE_FIREATNEUTRAL))
@@ -718,7 +743,7 @@ void CWeapon::HoldIfTargetInvalid()
 	if (!HaveTarget())
 		return;
 
-	if (!TryTarget(currentTarget)) {
+	if (!TryTargetCached(currentTarget)) {
 		DropCurrentTarget();
 		return;
 	}
@@ -837,7 +862,7 @@ float3 CWeapon::GetTargetBorderPos(
 }
 
 
-bool CWeapon::TryTarget(const float3 tgtPos, const SWeaponTarget& trg, bool preFire) const
+bool CWeapon::TryTarget(const float3 tgtPos, const SWeaponTarget& trg, bool preFire, bool useLOFCache) const
 {
 	assert(GetLeadTargetPos(trg).SqDistance(tgtPos) < Square(250.0f));
 
@@ -851,6 +876,9 @@ bool CWeapon::TryTarget(const float3 tgtPos, const SWeaponTarget& trg, bool preF
 		return false;
 
 	// TODO: add a forcedUserTarget (forced-fire mode enabled with CTRL e.g.) and skip the tests below
+	if (useLOFCache)
+		return (HaveFreeLineOfFireCached(GetAimFromPos(preFire), tgtPos, trg));
+
 	return (HaveFreeLineOfFire(GetAimFromPos(preFire), tgtPos, trg));
 }
 
@@ -990,6 +1018,59 @@ bool CWeapon::HaveFreeLineOfFire(const float3 srcPos, const float3 tgtPos, const
 }
 
 
+bool CWeapon::HaveFreeLineOfFireCached(const float3 srcPos, const float3 tgtPos, const SWeaponTarget& trg) const
+{
+	if (trg.type != Target_Unit)
+		return (HaveFreeLineOfFire(srcPos, tgtPos, trg));
+
+	// SlowUpdate tests the current target up to three times in a row
+	// (HoldIfTargetInvalid, AllowWeaponAutoTarget, AutoTarget) and
+	// UpdateFire once more in the same frame; each test traces the
+	// same ray
+	// all unit move-types have already run when weapons are updated,
+	// so mid-frame obstacles come from units or features that are
+	// created, killed or moved by Lua; any of these that changes the
+	// quadfield (as creation and death always do) drops the results
+	const unsigned int numSolidChanges = quadField->GetNumSolidChanges();
+
+	LineOfFireCacheEntry* oldestEntry = &lofCache[0];
+
+	for (LineOfFireCacheEntry& e: lofCache) {
+		if (e.frame < oldestEntry->frame)
+			oldestEntry = &e;
+
+		if (e.unitID != trg.unit->id)
+			continue;
+		if (e.frame != gs->frameNum)
+			continue;
+		if (e.numSolidChanges != numSolidChanges)
+			continue;
+		if (e.srcPos.SqDistance(srcPos) > Square(LOF_CACHE_TOLERANCE))
+			continue;
+		if (e.tgtPos.SqDistance(tgtPos) > Square(LOF_CACHE_TOLERANCE))
+			continue;
+
+		lofCacheHits++;
+		return e.result;
+	}
+
+	lofCacheMisses++;
+
+	*oldestEntry = {gs->frameNum, trg.unit->id, numSolidChanges, srcPos, tgtPos, HaveFreeLineOfFire(srcPos, tgtPos, trg)};
+	return oldestEntry->result;
+}
+
+
+void CWeapon::PrintDebugInfo()
+{
+	LOG("[Weapon] line-of-fire cache: lookups=%lu hits=%lu misses=%lu",
+		(unsigned long) (lofCacheHits + lofCacheMisses),
+		(unsigned long) lofCacheHits,
+		(unsigned long) lofCacheMisses
+	);
+}
+
+
 bool CWeapon::TryTarget(const SWeaponTarget& trg) const {
 	return TryTarget(GetLeadTargetPos(trg), trg);
 }
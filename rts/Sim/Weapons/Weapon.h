@@ -19,6 +19,7 @@ struct WeaponDef;
 class CWeapon : public CObject
 {
 	CR_DECLARE_DERIVED(CWeapon)
+	CR_DECLARE_SUB(LineOfFireCacheEntry)
 
 public:
 	CWeapon(CUnit* owner = nullptr, const WeaponDef* def = nullptr);
@@ -111,7 +112,10 @@ private:
 	void ReAimWeapon();
 	void HoldIfTargetInvalid();
 
-	bool TryTarget(const float3 tgtPos, const SWeaponTarget& trg, bool preFire = false) const;
+	bool TryTarget(const float3 tgtPos, const SWeaponTarget& trg, bool preFire = false, bool useLOFCache = false) const;
+	bool TryTargetCached(const SWeaponTarget& trg) const { return TryTarget(GetLeadTargetPos(trg), trg, false, true); }
+
+	bool HaveFreeLineOfFireCached(const float3 srcPos, const float3 tgtPos, const SWeaponTarget& trg) const;
 
 public:
 	CUnit* owner;
@@ -186,6 +190,11 @@ public:
 	int fireSoundId;
 	float fireSoundVolume;
 
+	static size_t lofCacheHits;
+	static size_t lofCacheMisses;
+
+	static void PrintDebugInfo();
+
 protected:
 	SWeaponTarget currentTarget;
 	float3 currentTargetPos;
@@ -193,6 +202,25 @@ protected:
 	// projectiles that are on the way to our interception zone
 	// (eg. nuke toward a repulsor, or missile toward a shield)
 	std::vector<int> incomingProjectileIDs;
+
+private:
+	// recent HaveFreeLineOfFire results for unit-targets; only the
+	// synced targeting code (SlowUpdate, UpdateFire) reads or fills
+	// these, never the public TryTarget used by GUI and Lua queries
+	struct LineOfFireCacheEntry {
+		CR_DECLARE_STRUCT(LineOfFireCacheEntry)
+
+		int frame;
+		int unitID;
+		unsigned int numSolidChanges;
+		float3 srcPos;
+		float3 tgtPos;
+		bool result;
+	};
+
+	static constexpr int LOF_CACHE_SIZE = 4;
+
+	mutable LineOfFireCacheEntry lofCache[LOF_CACHE_SIZE];
 };
 
 #endif /* WEAPON_H */
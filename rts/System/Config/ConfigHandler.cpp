@@ -55,11 +55,15 @@ protected:
 
 private:
 	void RemoveDefaults();
+	void RefreshValues(const std::string& key);
 
 	OverlayConfigSource* overlay;
 	FileConfigSource* writableSource;
 	std::vector<ReadOnlyConfigSource*> sources;
 
+	// cached handles, keyed by config name
+	spring::unsynced_map<std::string, std::vector<ConfigValueBase*>> configsToValues;
+
 	// observer related
 	spring::unsynced_map<std::string, std::vector<NamedConfigNotifyCallback>> configsToCallbacks;
 	spring::unsynced_map<void*, std::vector<std::string>> observersToConfigs;
@@ -119,6 +123,13 @@ ConfigHandlerImpl::ConfigHandlerImpl(const std::vector<std::string>& locations,
 
 	// Perform migrations that need to happen on every load.
 	RemoveDefaults();
+
+	for (ConfigValueBase* v = ConfigValueBase::GetValueList(); v != nullptr; v = v->next) {
+		configsToValues[v->GetKey()].push_back(v);
+	}
+	for (const auto& p: configsToValues) {
+		RefreshValues(p.first);
+	}
 }
 
 ConfigHandlerImpl::~ConfigHandlerImpl()
@@ -213,6 +224,8 @@ void ConfigHandlerImpl::Delete(const std::string& key)
 
 		rwcs->Delete(key);
 	}
+
+	RefreshValues(key);
 }
 
 bool ConfigHandlerImpl::IsSet(const std::string& key) const
@@ -272,8 +285,12 @@ void ConfigHandlerImpl::SetString(const std::string& key, const std::string& val
 {
 	// if we set something to be persisted,
 	// we do want to override the overlay value
-	if (!useOverlay)
+	if (!useOverlay) {
 		overlay->Delete(key);
+		// cached handles may still hold the overlay value, even if the
+		// persisted one below turns out to be unchanged
+		RefreshValues(key);
+	}
 
 	// Don't do anything if value didn't change.
 	if (IsSet(key) && GetString(key) == value)
@@ -307,6 +324,8 @@ void ConfigHandlerImpl::SetString(const std::string& key, const std::string& val
 		}
 	}
 
+	RefreshValues(key);
+
 	std::lock_guard<spring::mutex> lck(observerMutex);
 	changedValues[key] = value;
 }
@@ -329,6 +348,28 @@ void ConfigHandlerImpl::Update()
 	changedValues.clear();
 }
 
+/**
+ * @brief Re-resolves all cached handles of a key
+ *
+ * Called immediately (not deferred to Update) so a handle never lags
+ * behind GetString after a SetString from the same thread.
+ */
+void ConfigHandlerImpl::RefreshValues(const std::string& key)
+{
+	const auto it = configsToValues.find(key);
+
+	if (it == configsToValues.end())
+		return;
+	if (!IsSet(key))
+		return;
+
+	const std::string value = GetString(key);
+
+	for (ConfigValueBase* v: it->second) {
+		v->Parse(value);
+	}
+}
+
 std::string ConfigHandlerImpl::GetConfigFile() const {
 	return writableSource->GetFilename();
 }
@@ -369,6 +410,34 @@ void ConfigHandlerImpl::RemoveObserver(void* observer) {
 }
 
 
+/******************************************************************************/
+
+ConfigValueBase::ConfigValueBase(const char* k): key(k)
+{
+	// handles are static, so this runs single-threaded during static init
+	ConfigValueBase*& head = GetMutableValueList();
+
+	next = head;
+	head = this;
+}
+
+ConfigValueBase*& ConfigValueBase::GetMutableValueList()
+{
+	static ConfigValueBase* head = nullptr;
+	return head;
+}
+
+template<> void ConfigValue<bool>::Parse(const std::string& str)
+{
+	value = StringToBool(str);
+}
+
+template<> void ConfigValue<std::string>::Parse(const std::string& str)
+{
+	value = str;
+}
+
+
 /******************************************************************************/
 
 void ConfigHandler::Instantiate(const std::string configSource, const bool safemode)
@@ -12,6 +12,84 @@
 
 #include "ConfigVariable.h"
 
+/**
+ * @brief Untyped part of a cached config value handle
+ * @see ConfigValue
+ */
+class ConfigValueBase : public spring::noncopyable
+{
+public:
+	ConfigValueBase(const char* k);
+	virtual ~ConfigValueBase() {}
+
+	const char* GetKey() const { return key; }
+	const ConfigValueBase* GetNext() const { return next; }
+
+	/// @brief Head of the list of all statically declared handles
+	static ConfigValueBase* GetValueList() { return GetMutableValueList(); }
+
+protected:
+	friend class ConfigHandlerImpl;
+
+	/// @brief Called by the ConfigHandler whenever the resolved value may have changed
+	virtual void Parse(const std::string& value) = 0;
+
+private:
+	static ConfigValueBase*& GetMutableValueList();
+
+	const char* key;
+	ConfigValueBase* next;
+};
+
+/**
+ * @brief Cached, typed handle to a declared config variable
+ *
+ * The value is resolved (through all config sources, clamped) when the
+ * configHandler is instantiated and again right after the key is set or
+ * deleted through it, so reading it is a single load instead of a string
+ * keyed lookup + parse. Meant for variables queried on hot paths, e.g.
+ * every frame.
+ *
+ * Handles must have static storage duration so they are registered before
+ * the configHandler exists; use the CONFIG_VALUE macro next to the CONFIG
+ * declaration of the same variable:
+ *
+ * CONFIG(float, EdgeMoveWidth).defaultValue(0.02f);
+ * CONFIG_VALUE(float, EdgeMoveWidth);
+ * ...
+ * const float width = cfgValueEdgeMoveWidth.Get();
+ */
+template<typename T>
+class ConfigValue : public ConfigValueBase
+{
+public:
+	ConfigValue(const char* k): ConfigValueBase(k), value() {}
+
+	const T& Get() const { return value; }
+	operator const T&() const { return value; }
+
+protected:
+	void Parse(const std::string& str) {
+		std::istringstream buf(str);
+		buf >> value;
+	}
+
+private:
+	T value;
+};
+
+/// @brief <bool> specialization of Parse, uses the same rules as GetBool
+template<> void ConfigValue<bool>::Parse(const std::string& str);
+template<> void ConfigValue<std::string>::Parse(const std::string& str);
+
+/**
+ * @brief Declare a cached handle for a config variable declared with CONFIG.
+ * @see ConfigValue
+ */
+#define CONFIG_VALUE(T, name) \
+	static ConfigValue<T> cfgValue##name(#name)
+
+
 /**
  * @brief Config handler interface
  */
@@ -1,6 +1,8 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <memory>
 #include <sstream>
+#include <vector>
 #include <zlib.h>
 
 #include "ExternalAI/SkirmishAIHandler.h"
@@ -30,6 +32,7 @@
 #include "Sim/Units/Scripts/UnitScriptEngine.h"
 #include "Sim/Units/Scripts/NullUnitScript.h"
 #include "System/SafeUtil.h"
+#include "System/Misc/SpringTime.h"
 #include "System/Platform/errorhandler.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileQueryFlags.h"
@@ -128,7 +131,11 @@ void CCregLoadSaveHandler::SaveGame(const std::string& path)
 	LOG("[LSH::%s] saving game to \"%s\"", __func__, path.c_str());
 
 	try {
-		std::stringstream oss;
+		// owned by the compression job once the snapshot is taken
+		std::shared_ptr<std::stringstream> ossPtr = std::make_shared<std::stringstream>();
+		std::stringstream& oss = *ossPtr;
+
+		const spring_time t0 = spring_gettime();
 
 		// write our own header. SavePackage() will add its own
 		WriteString(oss, SpringVersion::GetSync());
@@ -158,6 +165,8 @@ void CCregLoadSaveHandler::SaveGame(const std::string& path)
 			PrintSize("AIs", ((int)oss.tellp()) - aiStart);
 		}
 
+		LOG("[LSH::%s] game-state snapshot took %ims", __func__, int((spring_gettime() - t0).toMilliSecsi()));
+
 		{
 			gzFile file = gzopen(dataDirsAccess.LocateFile(path, FileQueryFlags::WRITE).c_str(), "wb9");
 
@@ -166,16 +175,26 @@ void CCregLoadSaveHandler::SaveGame(const std::string& path)
 				return;
 			}
 
-			std::string data = std::move(oss.str());
-			std::function<void(gzFile, std::string&&)> func = [](gzFile file, std::string&& data) {
-				gzwrite(file, data.c_str(), data.size());
+			// stream the snapshot out in chunks straight from the stringbuf
+			// rather than first copying it into a string on this thread
+			std::function<void(gzFile, std::shared_ptr<std::stringstream>)> func = [](gzFile file, std::shared_ptr<std::stringstream> data) {
+				std::vector<char> chunk(1 << 20);
+				std::streambuf* sbuf = data->rdbuf();
+				std::streamsize size = 0;
+
+				sbuf->pubseekpos(0, std::ios_base::in);
+
+				while ((size = sbuf->sgetn(chunk.data(), chunk.size())) > 0) {
+					gzwrite(file, chunk.data(), size);
+				}
+
 				gzflush(file, Z_FINISH);
 				gzclose(file);
 			};
 
 			// gzFile is just a plain typedef (struct gzFile_s {}* gzFile), can be copied
 			// need to keep a reference to the future around or its destructor will block
-			ThreadPool::AddExtJob(std::move(std::async(std::launch::async, std::move(func), file, std::move(data))));
+			ThreadPool::AddExtJob(std::move(std::async(std::launch::async, std::move(func), file, std::move(ossPtr))));
 		}
 
 		//FIXME add lua state
@@ -201,10 +220,10 @@ void CCregLoadSaveHandler::LoadGameStartInfo(const std::string& path)
 	CGZFileHandler saveFile(dataDirsAccess.LocateFile(FindSaveFile(path)), SPRING_VFS_RAW_FIRST);
 	iss = new std::stringstream;
 	std::stringbuf *sbuf = iss->rdbuf();
-	char buf[4096];
+	std::vector<char> buf(1 << 16);
 	int len;
-	while ((len = saveFile.Read(buf, sizeof(buf))) > 0)
-		sbuf->sputn(buf, len);
+	while ((len = saveFile.Read(buf.data(), buf.size())) > 0)
+		sbuf->sputn(buf.data(), len);
 
 	//Check for compatible save versions
 	std::string saveVersion;
@@ -246,11 +265,15 @@ void CCregLoadSaveHandler::LoadGame()
 	void* pGSC = nullptr;
 	creg::Class* gsccls = nullptr;
 
+	const spring_time t0 = spring_gettime();
+
 	// load creg state
 	creg::CInputStreamSerializer inputStream;
 	inputStream.LoadPackage(iss, pGSC, gsccls);
 	assert(pGSC && gsccls == CGameStateCollector::StaticClass());
 
+	LOG("[LSH::%s] game-state load took %ims", __func__, int((spring_gettime() - t0).toMilliSecsi()));
+
 	// the only job of gsc is to collect gamestate data
 	CGameStateCollector* gsc = static_cast<CGameStateCollector*>(pGSC);
 	spring::SafeDelete(gsc);
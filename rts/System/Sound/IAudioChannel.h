@@ -5,6 +5,7 @@
 
 #include "System/float3.h"
 
+#include <atomic>
 #include <string>
 
 struct GuiSoundSet;
@@ -74,11 +75,12 @@ protected:
 
 public:
 	float volume;
-	bool enabled;
+	// read by FindSourceAndPlay, which sim and render code call without the sound mutex
+	std::atomic<bool> enabled;
 
 protected:
 	unsigned emitsPerFrame;
-	unsigned emitsThisFrame;
+	std::atomic<unsigned> emitsThisFrame;
 	unsigned maxConcurrentSources;
 };
 
@@ -1,5 +1,8 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+// must precede anything that defines likely() (e.g. float3.h)
+#include "System/ConcurrentQueue.h"
+
 #include "AudioChannel.h"
 
 #include "ALShared.h"
@@ -16,6 +19,20 @@
 
 extern spring::recursive_mutex soundMutex;
 
+struct AudioChannel::PlayRequestQueue: public moodycamel::ConcurrentQueue<PlayRequest> {
+};
+
+
+AudioChannel::AudioChannel()
+	: playRequests(new PlayRequestQueue())
+	, curStreamSrc(nullptr)
+{
+}
+
+AudioChannel::~AudioChannel()
+{
+}
+
 
 
 void AudioChannel::SetVolume(float newVolume)
@@ -63,8 +80,9 @@ void AudioChannel::SoundSourceFinished(CSoundSource* sndSource)
 
 void AudioChannel::FindSourceAndPlay(size_t id, const float3& pos, const float3& velocity, float volume, bool relative)
 {
-	std::lock_guard<spring::recursive_mutex> lck(soundMutex);
-
+	// NOTE:
+	//   called by sim and render code, does not take the sound mutex
+	//   sources are only handed out by the sound thread (UpdatePlayRequests)
 	if (!enabled)
 		return;
 
@@ -87,45 +105,60 @@ void AudioChannel::FindSourceAndPlay(size_t id, const float3& pos, const float3&
 		LOG("CSound::PlaySample: maxdist ignored for relative playback: %s", sndItem->Name().c_str());
 	}
 
-	// don't spam to many sounds per frame
-	if (emitsThisFrame >= emitsPerFrame)
+	// don't spam to many sounds per frame; callers can race, only
+	// the first emitsPerFrame of them get a ticket
+	if (emitsThisFrame.fetch_add(1) >= emitsPerFrame)
 		return;
-	emitsThisFrame++;
 
-	// check if the sound item is already played
-	if (curSources.size() >= maxConcurrentSources) {
-		CSoundSource* src = nullptr;
+	playRequests->enqueue({sndItem, pos, velocity, volume, relative});
+}
 
-		int prio = INT_MAX;
+void AudioChannel::UpdatePlayRequests()
+{
+	PlayRequest req;
 
-		for (auto it = curSources.begin(); it != curSources.end(); ++it) {
-			if ((*it)->GetCurrentPriority() < prio) {
-				src  = *it;
-				prio = src->GetCurrentPriority();
+	while (playRequests->try_dequeue(req)) {
+		SoundItem* sndItem = req.item;
+
+		// channel may have been disabled since the request was queued
+		if (!enabled)
+			continue;
+
+		// check if the sound item is already played
+		if (curSources.size() >= maxConcurrentSources) {
+			CSoundSource* src = nullptr;
+
+			int prio = INT_MAX;
+
+			for (auto it = curSources.begin(); it != curSources.end(); ++it) {
+				if ((*it)->GetCurrentPriority() < prio) {
+					src  = *it;
+					prio = src->GetCurrentPriority();
+				}
 			}
-		}
 
-		if (src == nullptr || prio > sndItem->GetPriority()) {
-			LOG_L(L_DEBUG, "CSound::PlaySample: Max concurrent sounds in channel reached! Dropping playback!");
-			return;
+			if (src == nullptr || prio > sndItem->GetPriority()) {
+				LOG_L(L_DEBUG, "CSound::PlaySample: Max concurrent sounds in channel reached! Dropping playback!");
+				continue;
+			}
+
+			src->Stop();
 		}
 
-		src->Stop();
-	}
+		// find a sound source to play the item in
+		CSoundSource* sndSource = sound->GetNextBestSource(false);
 
-	// find a sound source to play the item in
-	CSoundSource* sndSource = sound->GetNextBestSource();
+		if (sndSource == nullptr || (sndSource->GetCurrentPriority() >= sndItem->GetPriority())) {
+			LOG_L(L_DEBUG, "CSound::PlaySample: Max sounds reached! Dropping playback!");
+			continue;
+		}
+		if (sndSource->IsPlaying())
+			sound->numAbortedPlays++;
 
-	if (sndSource == nullptr || (sndSource->GetCurrentPriority() >= sndItem->GetPriority())) {
-		LOG_L(L_DEBUG, "CSound::PlaySample: Max sounds reached! Dropping playback!");
-		return;
+		// play the sound item
+		sndSource->PlayAsync(this, sndItem, req.pos, req.velocity, req.volume, req.relative);
+		curSources.insert(sndSource);
 	}
-	if (sndSource->IsPlaying())
-		sound->numAbortedPlays++;
-
-	// play the sound item
-	sndSource->PlayAsync(this, sndItem, pos, velocity, volume, relative);
-	curSources.insert(sndSource);
 }
 
 void AudioChannel::PlaySample(size_t id, float volume)
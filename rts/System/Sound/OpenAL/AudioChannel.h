@@ -3,6 +3,7 @@
 #ifndef AUDIO_CHANNEL_H
 #define AUDIO_CHANNEL_H
 
+#include <memory>
 #include <vector>
 #include <cstring>
 
@@ -12,6 +13,7 @@
 struct GuiSoundSet;
 class CSoundSource;
 class CWorldObject;
+class SoundItem;
 
 /**
  * @brief Channel for playing sounds
@@ -23,8 +25,21 @@ class AudioChannel : public IAudioChannel {
 private:
 	typedef std::pair<std::string, float> StreamQueueItem;
 
+	struct PlayRequest {
+		SoundItem* item;
+
+		float3 pos;
+		float3 velocity;
+
+		float volume;
+		bool relative;
+	};
+
+	struct PlayRequestQueue;
+
 public:
-	AudioChannel(): curStreamSrc(nullptr) {}
+	AudioChannel();
+	~AudioChannel();
 
 	void Enable(bool newState);
 	void SetVolume(float newVolume);
@@ -51,6 +66,13 @@ public:
 	float StreamGetTime();
 	float StreamGetPlayTime();
 
+	/**
+	 * @brief Assign sources to the queued play-requests
+	 *
+	 * Called by the sound thread (with the sound mutex held).
+	 */
+	void UpdatePlayRequests();
+
 protected:
 	void FindSourceAndPlay(size_t id, const float3& pos, const float3& velocity, float volume, bool relative);
 
@@ -60,6 +82,9 @@ private:
 	spring::unsynced_set<CSoundSource*> curSources;
 	std::vector<StreamQueueItem> streamQueue;
 
+	// filled by FindSourceAndPlay from any thread without locking
+	std::unique_ptr<PlayRequestQueue> playRequests;
+
 	CSoundSource* curStreamSrc;
 
 	static constexpr size_t MAX_STREAM_QUEUESIZE = 10;
@@ -18,6 +18,7 @@
 
 #include "System/Sound/ISoundChannels.h"
 #include "System/Sound/SoundLog.h"
+#include "AudioChannel.h"
 #include "SoundSource.h"
 #include "SoundBuffer.h"
 #include "SoundItem.h"
@@ -99,6 +100,8 @@ CSound::~CSound()
 
 bool CSound::HasSoundItem(const std::string& name) const
 {
+	std::lock_guard<spring::mutex> lck(soundItemsMutex);
+
 	if (soundMap.find(name) != soundMap.end())
 		return true;
 
@@ -107,11 +110,23 @@ bool CSound::HasSoundItem(const std::string& name) const
 
 size_t CSound::GetSoundId(const std::string& name)
 {
-	std::lock_guard<spring::recursive_mutex> lck(soundMutex);
-
 	if (soundSources.empty())
 		return 0;
 
+	{
+		// fast path; items are only ever added, so a hit stays valid
+		std::lock_guard<spring::mutex> lck(soundItemsMutex);
+
+		const auto it = soundMap.find(name);
+
+		if (it != soundMap.end())
+			return it->second;
+	}
+
+	// slow path, may create buffers; keep the lock order
+	std::lock_guard<spring::recursive_mutex> lck(soundMutex);
+	std::lock_guard<spring::mutex> itemsLck(soundItemsMutex);
+
 	const auto it = soundMap.find(name);
 	if (it != soundMap.end())
 		return it->second;
@@ -133,6 +148,8 @@ size_t CSound::GetSoundId(const std::string& name)
 }
 
 SoundItem* CSound::GetSoundItem(size_t id) const {
+	std::lock_guard<spring::mutex> lck(soundItemsMutex);
+
 	// id==0 is a special id and invalid
 	if (id == 0 || id >= soundItems.size())
 		return nullptr;
@@ -140,6 +157,7 @@ SoundItem* CSound::GetSoundItem(size_t id) const {
 	// WARNING:
 	//   leaked to SoundSource::PlayAsync via AudioChannel::FindSourceAndPlay
 	//   soundItems vector grows on-demand via GetSoundId -> MakeItemFromDef
+	//   (items themselves are never deleted before the sound thread exits)
 	return soundItems[id];
 }
 
@@ -149,31 +167,78 @@ CSoundSource* CSound::GetNextBestSource(bool lock)
 	if (lock)
 		lck.lock();
 
-	if (soundSources.empty())
+	if (sourceHeap.empty())
 		return nullptr;
 
-	// find a free source; pointer remains valid until thread exits
-	for (CSoundSource& src: soundSources) {
-		if (!src.IsPlaying(false))
-			return &src;
+	// a free source if any (these have the lowest priority), otherwise
+	// the one playing the least important sound; pointer remains valid
+	// until thread exits
+	return &soundSources[sourceHeap[0]];
+}
+
+
+void CSound::UpdateSourcePriority(const CSoundSource* src)
+{
+	// sources are being created or destroyed
+	if (sourceHeap.empty() || sourceHeap.size() != soundSources.size())
+		return;
+
+	const size_t srcIdx = src - &soundSources[0];
+	const int newPriority = src->GetCurrentPriority();
+	const int oldPriority = sourcePriorities[srcIdx];
+
+	if (newPriority == oldPriority)
+		return;
+
+	sourcePriorities[srcIdx] = newPriority;
+
+	if (newPriority < oldPriority) {
+		SourceHeapSiftUp(sourceHeapPositions[srcIdx]);
+	} else {
+		SourceHeapSiftDown(sourceHeapPositions[srcIdx]);
 	}
+}
 
-	// check the next best free source
-	CSoundSource* bestSrc = nullptr;
-	int bestPriority = INT_MAX;
-
-	for (CSoundSource& src: soundSources) {
-		#if 0
-		if (!src.IsPlaying(true))
-			return &src;
-		#endif
-		if (src.GetCurrentPriority() <= bestPriority) {
-			bestSrc = &src;
-			bestPriority = src.GetCurrentPriority();
-		}
+void CSound::SourceHeapSwap(size_t i, size_t j)
+{
+	std::swap(sourceHeap[i], sourceHeap[j]);
+
+	sourceHeapPositions[sourceHeap[i]] = i;
+	sourceHeapPositions[sourceHeap[j]] = j;
+}
+
+void CSound::SourceHeapSiftUp(size_t i)
+{
+	while (i > 0) {
+		const size_t parent = (i - 1) >> 1;
+
+		if (!SourceHeapLess(sourceHeap[i], sourceHeap[parent]))
+			break;
+
+		SourceHeapSwap(i, parent);
+		i = parent;
 	}
+}
+
+void CSound::SourceHeapSiftDown(size_t i)
+{
+	while (true) {
+		const size_t lChild = (i << 1) + 1;
+		const size_t rChild = (i << 1) + 2;
+
+		size_t minIdx = i;
 
-	return bestSrc;
+		if (lChild < sourceHeap.size() && SourceHeapLess(sourceHeap[lChild], sourceHeap[minIdx]))
+			minIdx = lChild;
+		if (rChild < sourceHeap.size() && SourceHeapLess(sourceHeap[rChild], sourceHeap[minIdx]))
+			minIdx = rChild;
+
+		if (minIdx == i)
+			break;
+
+		SourceHeapSwap(i, minIdx);
+		i = minIdx;
+	}
 }
 
 void CSound::PitchAdjust(const float newPitch)
@@ -402,7 +467,13 @@ void CSound::UpdateThread(int cfgMaxSounds)
 
 	LOG("[Sound::%s][3] efx=%p", __func__, efx);
 
-	soundSources.clear();
+	{
+		std::lock_guard<spring::recursive_mutex> lck(soundMutex);
+
+		// stops UpdateSourcePriority from touching the heap
+		sourceHeap.clear();
+		soundSources.clear();
+	}
 
 	// must happen after sources and before context
 	spring::SafeDelete(efx);
@@ -423,6 +494,13 @@ void CSound::Update()
 {
 	std::lock_guard<spring::recursive_mutex> lck(soundMutex); // lock
 
+	// hand out sources to the play-requests queued since the last update,
+	// the sources then start playing them below
+	static_cast<AudioChannel*>(Channels::General)->UpdatePlayRequests();
+	static_cast<AudioChannel*>(Channels::Battle)->UpdatePlayRequests();
+	static_cast<AudioChannel*>(Channels::UnitReply)->UpdatePlayRequests();
+	static_cast<AudioChannel*>(Channels::UserInterface)->UpdatePlayRequests();
+
 	for (CSoundSource& source: soundSources)
 		source.Update();
 
@@ -520,6 +598,7 @@ bool CSound::LoadSoundDefsImpl(const std::string& fileName, const std::string& m
 {
 	//! can be called from LuaUnsyncedCtrl too
 	std::lock_guard<spring::recursive_mutex> lck(soundMutex);
+	std::lock_guard<spring::mutex> itemsLck(soundItemsMutex);
 
 	LuaParser parser(fileName, modes, modes);
 	parser.Execute();
@@ -692,5 +771,15 @@ void CSound::GenSources(int alMaxSounds)
 		LOG_L(L_WARNING, "[Sound::%s] alMaxSounds=%d but numSources=%d", __func__, alMaxSounds, int(soundSources.size()));
 		break;
 	}
+
+	// all sources start out idle, any order is a valid heap
+	sourceHeap.resize(soundSources.size());
+	sourceHeapPositions.resize(soundSources.size());
+	sourcePriorities.assign(soundSources.size(), INT_MIN);
+
+	for (size_t i = 0; i < soundSources.size(); i++) {
+		sourceHeap[i] = i;
+		sourceHeapPositions[i] = i;
+	}
 }
 
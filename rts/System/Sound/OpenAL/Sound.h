@@ -52,6 +52,9 @@ public:
 	bool LoadSoundDefsImpl(const std::string& fileName, const std::string& modes);
 	const float3& GetListenerPos() const { return myPos; }
 
+	/// called by sources whenever their priority may have changed
+	void UpdateSourcePriority(const CSoundSource* src);
+
 private:
 	typedef spring::unordered_map<std::string, std::string> SoundItemNameMap;
 	typedef spring::unordered_map<std::string, SoundItemNameMap> SoundItemDefsMap;
@@ -69,12 +72,32 @@ private:
 	size_t MakeItemFromDef(const SoundItemNameMap& itemDef);
 	size_t LoadSoundBuffer(const std::string& filename);
 
+	bool SourceHeapLess(int a, int b) const {
+		return (sourcePriorities[a] < sourcePriorities[b] || (sourcePriorities[a] == sourcePriorities[b] && a < b));
+	}
+	void SourceHeapSwap(size_t i, size_t j);
+	void SourceHeapSiftUp(size_t i);
+	void SourceHeapSiftDown(size_t i);
+
 private:
 	spring::thread soundThread;
-	spring::unordered_map<std::string, size_t> soundMap; // <name, id>
+	spring::unsynced_map<std::string, size_t> soundMap; // <name, id>
 	std::vector<SoundItem*> soundItems;
 	std::vector<CSoundSource> soundSources; // fixed-size
 
+	// min-heap of indices into soundSources keyed by current priority,
+	// idle sources (INT_MIN) come first; guarded by soundMutex
+	std::vector<int> sourceHeap;
+	std::vector<int> sourceHeapPositions;
+	std::vector<int> sourcePriorities;
+
+	/**
+	 * Guards soundMap and soundItems, such that id lookups by the sim
+	 * and render threads do not contend with the sound thread (which
+	 * never takes this lock). Always acquired after soundMutex.
+	 */
+	mutable spring::mutex soundItemsMutex;
+
 	SoundItemNameMap defaultItemNameMap;
 	SoundItemDefsMap soundItemDefsMap;
 
@@ -97,6 +97,15 @@ void CSoundSource::Update()
 		alSourcei(id, AL_DIRECT_FILTER, efx->sfxFilter);
 		efxUpdates = efx->updates;
 	}
+
+	PriorityChanged();
+}
+
+void CSoundSource::PriorityChanged() const
+{
+	// NOTE: CSoundSource is only used by the OpenAL implementation
+	if (sound != nullptr)
+		static_cast<CSound*>(sound)->UpdateSourcePriority(this);
 }
 
 int CSoundSource::GetCurrentPriority() const
@@ -153,6 +162,7 @@ void CSoundSource::Stop()
 		oldChannel->SoundSourceFinished(this);
 	}
 	CheckError("CSoundSource::Stop");
+	PriorityChanged();
 }
 
 void CSoundSource::Play(IAudioChannel* channel, SoundItem* item, float3 pos, float3 velocity, float volume, bool relative)
@@ -231,6 +241,7 @@ void CSoundSource::Play(IAudioChannel* channel, SoundItem* item, float3 pos, flo
 		LOG_L(L_WARNING, "CSoundSource::Play: Empty buffer for item %s (file %s)", item->name.c_str(), item->buffer->GetFilename().c_str());
 
 	CheckError("CSoundSource::Play");
+	PriorityChanged();
 }
 
 
@@ -242,6 +253,8 @@ void CSoundSource::PlayAsync(IAudioChannel* channel, SoundItem* buffer, float3 p
 	asyncPlay.velocity = velocity;
 	asyncPlay.volume   = volume;
 	asyncPlay.relative = relative;
+
+	PriorityChanged();
 }
 
 
@@ -275,6 +288,7 @@ void CSoundSource::PlayStream(IAudioChannel* channel, const std::string& file, f
 	curStream.Play(file, volume);
 	curStream.Update();
 	CheckError("CSoundSource::Update");
+	PriorityChanged();
 }
 
 void CSoundSource::StreamStop()
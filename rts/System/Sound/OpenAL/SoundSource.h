@@ -55,6 +55,10 @@ public:
 	static void SetPitch(const float& newPitch) { globalPitch = newPitch; }
 	static void SetHeightRolloffModifer(const float& mod) { heightRolloffModifier = mod; }
 
+private:
+	/// keeps the sound system's source priority-heap up to date
+	void PriorityChanged() const;
+
 private:
 	struct AsyncSoundItemData {
 		IAudioChannel* channel;
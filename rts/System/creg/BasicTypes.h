@@ -4,6 +4,20 @@
 #define CR_BASIC_TYPES_H
 
 namespace creg {
+	// containers of integers, enums or floats that keep their elements in
+	// one block; these are handed to ISerializer::SerializeIntArray as a
+	// whole rather than element by element (the encoding is identical)
+	template<typename T> struct IsBulkSerializable {
+		static constexpr bool value = false;
+	};
+	template<typename E, typename A> struct IsBulkSerializable< std::vector<E, A> > {
+		static constexpr bool value = (std::is_arithmetic<E>::value || std::is_enum<E>::value) && !std::is_same<E, bool>::value;
+	};
+	template<typename C, typename Tr, typename A> struct IsBulkSerializable< std::basic_string<C, Tr, A> > {
+		static constexpr bool value = true;
+	};
+
+
 	// vector,deque container
 	template<typename T>
 	class DynamicArrayType : public IType
@@ -23,21 +37,29 @@ namespace creg {
 			if (s->IsWriting()) {
 				int size = (int)ct.size();
 				s->SerializeInt(&size, sizeof(int));
-				for (int a = 0; a < size; a++) {
-					elemType->Serialize(s, &ct[a]);
-				}
+				SerializeElements(s, ct, size);
 			} else {
 				ct.clear();
 				int size;
 				s->SerializeInt(&size, sizeof(int));
 				ct.resize(size);
-				for (int a = 0; a < size; a++) {
-					elemType->Serialize(s, &ct[a]);
-				}
+				SerializeElements(s, ct, size);
 			}
 		}
 		std::string GetName() const { return elemType->GetName() + "[]"; }
 		size_t GetSize() const { return sizeof(T); }
+
+	private:
+		void SerializeElements(ISerializer* s, T& ct, int size) {
+			if (IsBulkSerializable<T>::value && size > 0) {
+				s->SerializeIntArray(&ct[0], sizeof(ElemT), size);
+				return;
+			}
+
+			for (int a = 0; a < size; a++) {
+				elemType->Serialize(s, &ct[a]);
+			}
+		}
 	};
 
 	class StaticArrayBaseType : public IType
@@ -64,6 +86,12 @@ namespace creg {
 		void Serialize(ISerializer* s, void* instance)
 		{
 			T* array = (T*)instance;
+
+			if (std::is_arithmetic<T>::value || std::is_enum<T>::value) {
+				s->SerializeIntArray(array, sizeof(T), Size);
+				return;
+			}
+
 			for (int a = 0; a < Size; a++)
 				elemType->Serialize(s, &array[a]);
 		}
@@ -112,10 +140,8 @@ namespace creg {
 
 		void Serialize(ISerializer* s, void* instance)
 		{
-			for (int a=0;a<size;a++) {
-				char c=0;
-				s->Serialize(&c,1);
-			}
+			std::vector<char> c(size, 0);
+			s->Serialize(c.data(), size);
 		}
 		std::string GetName() const
 		{
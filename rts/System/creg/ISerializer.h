@@ -21,6 +21,14 @@ namespace creg
 		virtual void SerializeInt(void* data, int byteSize) = 0;
 		template <typename T> void SerializeInt(T* data) { SerializeInt(data, sizeof(T)); }
 
+		/// Serialize <count> contiguous integer values of <byteSize> bytes each,
+		/// equivalent to (but faster than) calling SerializeInt for every element
+		virtual void SerializeIntArray(void* data, int byteSize, int count) {
+			for (int i = 0; i < count; i++) {
+				SerializeInt(static_cast<char*>(data) + i * byteSize, byteSize);
+			}
+		}
+
 		/// Serialize a pointer to an instance of a creg registered class/struct
 		virtual void SerializeObjectPtr(void** ptr, Class* objectClass) = 0;
 		
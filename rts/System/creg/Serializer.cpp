@@ -85,14 +85,37 @@ static void WriteZStr(std::ostream& file, const std::string& str)
 }
 
 
+// encodes <v> into <buf> (which must hold at least 10 bytes), returns the number of bytes used
+static inline size_t EncodeVarSizeUInt(std::uint64_t v, unsigned char* buf)
+{
+	size_t n = 0;
+
+	do {
+		unsigned char a = v & 0x7F;
+		v >>= 7;
+
+		if (v > 0)
+			a |= 0x80;
+
+		buf[n++] = a;
+	} while (v > 0);
+
+	return n;
+}
+
 template<typename T>
 void ReadVarSizeUInt(std::istream* stream, T* buf)
 {
+	// go through the streambuf directly, istream::read
+	// constructs a sentry object for every single byte
+	std::streambuf* sb = stream->rdbuf();
 	std::uint64_t val = 0;
 	unsigned offset = 0;
 	while (true) {
-		unsigned char a;
-		stream->read((char*)&a, sizeof(char));
+		const int a = sb->sbumpc();
+
+		if (a == std::char_traits<char>::eof())
+			throw std::runtime_error("Unexpected end of object package");
 
 		val += ((std::uint64_t)(a & 0x7F)) << offset;
 		if ((a & 0x80) == 0)
@@ -108,18 +131,48 @@ void ReadVarSizeUInt(std::istream* stream, T* buf)
 template<typename T>
 void WriteVarSizeUInt(std::ostream* stream, T val)
 {
-	std::uint64_t v = val;
-	do {
-		unsigned char a = v & 0x7F;
-		v >>= 7;
+	unsigned char buf[16];
+	stream->write((const char*)buf, EncodeVarSizeUInt(val, buf));
+}
 
-		if (v > 0)
-			a |= 0x80;
 
-		stream->write((char*)&a, sizeof(char));
-	} while (v > 0);
+// bulk versions for arrays of integers (or of floats stored as such)
+template<typename T>
+static void ReadVarSizeUIntArray(std::istream* stream, char* data, int count)
+{
+	for (int i = 0; i < count; i++) {
+		std::uint64_t x = 0;
+		ReadVarSizeUInt(stream, &x);
+
+		const T v = x;
+		memcpy(data + i * sizeof(T), &v, sizeof(T));
+	}
+}
+
+template<typename T>
+static void WriteVarSizeUIntArray(std::ostream* stream, const char* data, int count)
+{
+	// encode into a local buffer and hand it to the stream in large chunks
+	unsigned char buf[4096 + 16];
+	size_t n = 0;
+
+	for (int i = 0; i < count; i++) {
+		T v;
+		memcpy(&v, data + i * sizeof(T), sizeof(T));
+
+		n += EncodeVarSizeUInt(v, &buf[n]);
+
+		if (n < 4096)
+			continue;
+
+		stream->write((const char*)buf, n);
+		n = 0;
+	}
+
+	stream->write((const char*)buf, n);
 }
 
+
 //-------------------------------------------------------------------------
 // Base output serializer
 //-------------------------------------------------------------------------
@@ -268,6 +321,20 @@ void COutputStreamSerializer::SerializeInt(void* data, int byteSize)
 }
 
 
+void COutputStreamSerializer::SerializeIntArray(void* data, int byteSize, int count)
+{
+	switch (byteSize) {
+		case 1: { WriteVarSizeUIntArray<std::uint8_t >(stream, (const char*)data, count); break; }
+		case 2: { WriteVarSizeUIntArray<std::uint16_t>(stream, (const char*)data, count); break; }
+		case 4: { WriteVarSizeUIntArray<std::uint32_t>(stream, (const char*)data, count); break; }
+		case 8: { WriteVarSizeUIntArray<std::uint64_t>(stream, (const char*)data, count); break; }
+		default: {
+			throw "Unknown int type";
+		}
+	}
+}
+
+
 struct COutputStreamSerializer::ClassRef
 {
 	int index;
@@ -484,6 +551,19 @@ void CInputStreamSerializer::SerializeInt(void* data, int byteSize)
 	}
 }
 
+void CInputStreamSerializer::SerializeIntArray(void* data, int byteSize, int count)
+{
+	switch (byteSize) {
+		case 1: { ReadVarSizeUIntArray<std::uint8_t >(stream, (char*)data, count); break; }
+		case 2: { ReadVarSizeUIntArray<std::uint16_t>(stream, (char*)data, count); break; }
+		case 4: { ReadVarSizeUIntArray<std::uint32_t>(stream, (char*)data, count); break; }
+		case 8: { ReadVarSizeUIntArray<std::uint64_t>(stream, (char*)data, count); break; }
+		default: {
+			throw "Unknown int type";
+		}
+	}
+}
+
 void CInputStreamSerializer::SerializeObjectPtr(void** ptr, creg::Class* cls)
 {
 	unsigned int id;
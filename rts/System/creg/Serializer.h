@@ -13,6 +13,8 @@
 #include <deque>
 #include <istream>
 
+#include "System/UnorderedMap.hpp"
+
 namespace creg {
 
 	/**
@@ -81,7 +83,7 @@ namespace creg {
 		struct ClassRef;
 
 		std::ostream* stream;
-		std::map<void*,std::vector<ObjectRef*> > ptrToId;
+		spring::unsynced_map<void*, std::vector<ObjectRef*> > ptrToId;
 		std::deque<ObjectRef> objects;
 		std::vector<ObjectRef*> pendingObjects; // these objects still have to be saved
 		std::map<Class*, int> classSizes;
@@ -122,6 +124,9 @@ namespace creg {
 		/** @see ISerializer::SerializeInt */
 		void SerializeInt(void* data, int byteSize);
 
+		/** @see ISerializer::SerializeIntArray */
+		void SerializeIntArray(void* data, int byteSize, int count);
+
 		/** Empty function, only applies to loading */
 		void AddPostLoadCallback(void (*cb)(void* d), void* d) {}
 	};
@@ -177,6 +182,9 @@ namespace creg {
 		/** @see ISerializer::SerializeInt */
 		void SerializeInt(void* data, int byteSize);
 
+		/** @see ISerializer::SerializeIntArray */
+		void SerializeIntArray(void* data, int byteSize, int count);
+
 		/** @see ISerializer::AddPostLoadCallback */
 		void AddPostLoadCallback(void (*cb)(void* userdata), void* userdata);
 
@@ -1,7 +1,14 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include "Sim/Misc/CollisionHandler.h"
+#include "Sim/Misc/CollisionVolume.h"
+#include "Sim/Misc/CollisionVolumeBatch.h"
 #include "System/float3.h"
+#include "System/Matrix44f.h"
 #include "System/myMath.h"
+#include <chrono>
+#include <cstring>
+#include <random>
 #include <stdlib.h>
 #include <time.h>
 
@@ -159,3 +166,173 @@ BOOST_AUTO_TEST_CASE( Ellipsoid )
 
 	BOOST_CHECK_MESSAGE(failCount < MAX_FAILS, "Inaccurate ellipsoid distance approximation!");
 }
+
+
+
+#define BATCH_TEST_RAYS 20000
+#define BATCH_BENCH_RAYS 200000
+
+struct BatchVolume {
+	CMatrix44f mat;
+	float3 hs;
+	float3 his;
+	int type;
+};
+
+static BatchVolume RandomBatchVolume(std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> angle(-math::PI, math::PI);
+	std::uniform_real_distribution<float> offset(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> scale(1.0f, 40.0f);
+
+	BatchVolume v;
+	v.mat.Translate(offset(rng), offset(rng), offset(rng));
+	v.mat.RotateEulerXYZ(float3(angle(rng), angle(rng), angle(rng)));
+
+	if ((rng() & 3) == 0) {
+		v.hs = OnesVector * scale(rng);
+		v.type = CollisionVolume::COLVOL_TYPE_SPHERE;
+	} else {
+		v.hs = float3(scale(rng), scale(rng), scale(rng));
+		v.type = CollisionVolume::COLVOL_TYPE_ELLIPSOID;
+	}
+
+	v.his = float3(1.0f / v.hs.x, 1.0f / v.hs.y, 1.0f / v.hs.z);
+	return v;
+}
+
+static float3 RandomRayPoint(std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> coor(-100.0f, 100.0f);
+	return {coor(rng), coor(rng), coor(rng)};
+}
+
+// the scalar path as taken by CCollisionHandler::Intersect (minus the final world-space transform)
+static bool ScalarIntersect(const BatchVolume& v, const float3& p0, const float3& p1, CollisionQuery* q)
+{
+	const CMatrix44f mInv = v.mat.InvertAffine();
+	const float3 pi0 = mInv.Mul(p0);
+	const float3 pi1 = mInv.Mul(p1);
+
+	const float rminx = std::min(pi0.x, pi1.x), rminy = std::min(pi0.y, pi1.y), rminz = std::min(pi0.z, pi1.z);
+	const float rmaxx = std::max(pi0.x, pi1.x), rmaxy = std::max(pi0.y, pi1.y), rmaxz = std::max(pi0.z, pi1.z);
+
+	if (rmaxx < -v.hs.x || rminx > v.hs.x) { return false; }
+	if (rmaxy < -v.hs.y || rminy > v.hs.y) { return false; }
+	if (rmaxz < -v.hs.z || rminz > v.hs.z) { return false; }
+
+	return (CollisionVolumeBatch::IntersectEllipsoid(v.hs, v.his, pi0, pi1, q));
+}
+
+static void FillBatch(CollisionVolumeBatch& batch, const std::vector<BatchVolume>& vols, size_t first)
+{
+	batch.Clear();
+
+	for (size_t i = first; i < vols.size() && !batch.Full(); i++) {
+		batch.Add(vols[i].mat, vols[i].hs, vols[i].his, vols[i].type, &vols[i]);
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE( EllipsoidBatch )
+{
+	std::mt19937 rng(1234);
+	std::vector<BatchVolume> vols;
+
+	// not a multiple of the SIMD width, exercises the padding lanes
+	for (size_t i = 0; i < (CollisionVolumeBatch::NUM_LANES - 3); i++) {
+		vols.push_back(RandomBatchVolume(rng));
+	}
+
+	CollisionVolumeBatch batch;
+	CollisionQuery bcqs[CollisionVolumeBatch::NUM_LANES];
+	bool bhits[CollisionVolumeBatch::NUM_LANES];
+
+	unsigned int numHits = 0;
+	unsigned int numMismatches = 0;
+
+	for (int n = 0; n < BATCH_TEST_RAYS; n++) {
+		const float3 p0 = RandomRayPoint(rng);
+		const float3 p1 = ((n & 7) == 0)? p0: RandomRayPoint(rng); // some degenerate rays
+
+		FillBatch(batch, vols, 0);
+		std::fill(bcqs, bcqs + batch.Size(), CollisionQuery());
+		std::fill(bhits, bhits + batch.Size(), false);
+
+		batch.TransformRay(p0, p1);
+		batch.IntersectEllipsoids(bcqs, bhits);
+
+		for (size_t i = 0; i < batch.Size(); i++) {
+			CollisionQuery scq;
+			const bool shit = ScalarIntersect(vols[i], p0, p1, &scq);
+
+			numHits += shit;
+
+			// results have to be bit-identical, not merely close
+			if (shit != bhits[i] || std::memcmp(&scq, &bcqs[i], sizeof(CollisionQuery)) != 0)
+				numMismatches += 1;
+		}
+	}
+
+	printf("[EllipsoidBatch] %u volume-tests, %u hits, %u mismatches\n", unsigned(BATCH_TEST_RAYS * vols.size()), numHits, numMismatches);
+
+	BOOST_CHECK(numHits > 0);
+	BOOST_CHECK(numMismatches == 0);
+}
+
+
+BOOST_AUTO_TEST_CASE( EllipsoidBatchThroughput )
+{
+	std::mt19937 rng(5678);
+	std::vector<BatchVolume> vols;
+	std::vector<float3> rays;
+
+	for (size_t i = 0; i < CollisionVolumeBatch::NUM_LANES; i++) {
+		vols.push_back(RandomBatchVolume(rng));
+	}
+	for (int n = 0; n < BATCH_BENCH_RAYS; n++) {
+		rays.push_back(RandomRayPoint(rng));
+		rays.push_back(RandomRayPoint(rng));
+	}
+
+	CollisionVolumeBatch batch;
+	CollisionQuery cqs[CollisionVolumeBatch::NUM_LANES];
+	bool hits[CollisionVolumeBatch::NUM_LANES];
+
+	unsigned int scalarHits = 0;
+	unsigned int batchHits = 0;
+
+	const auto t0 = std::chrono::high_resolution_clock::now();
+
+	for (int n = 0; n < BATCH_BENCH_RAYS; n++) {
+		for (const BatchVolume& v: vols) {
+			CollisionQuery cq;
+			scalarHits += ScalarIntersect(v, rays[n * 2 + 0], rays[n * 2 + 1], &cq);
+		}
+	}
+
+	const auto t1 = std::chrono::high_resolution_clock::now();
+
+	for (int n = 0; n < BATCH_BENCH_RAYS; n++) {
+		// includes the per-volume matrix inversion, as the scalar path does
+		FillBatch(batch, vols, 0);
+		std::fill(cqs, cqs + batch.Size(), CollisionQuery());
+		std::fill(hits, hits + batch.Size(), false);
+
+		if (batch.TransformRay(rays[n * 2 + 0], rays[n * 2 + 1]) == 0)
+			continue;
+
+		batch.IntersectEllipsoids(cqs, hits);
+		batchHits += std::count(hits, hits + batch.Size(), true);
+	}
+
+	const auto t2 = std::chrono::high_resolution_clock::now();
+
+	const float numTests = float(BATCH_BENCH_RAYS) * vols.size();
+	const float scalarNS = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / numTests;
+	const float batchNS = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / numTests;
+
+	printf("[EllipsoidBatchThroughput] scalar: %.2fns per volume-test, batch: %.2fns per volume-test (%u hits)\n", scalarNS, batchNS, batchHits);
+
+	BOOST_CHECK(scalarHits == batchHits);
+}
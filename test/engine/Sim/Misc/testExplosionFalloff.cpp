@@ -0,0 +1,91 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Sim/Misc/ExplosionFalloff.h"
+#include "System/Log/ILog.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_MODULE ExplosionFalloff
+#include <boost/test/unit_test.hpp>
+
+static constexpr size_t NUM_EXPLOSIONS = 4096;
+
+
+// the falloff as CGameHelper::DoExplosionDamage computed it inline
+static float ReferenceDistanceMod(float expRadius, float expDist, float expEdgeEffect)
+{
+	const float expRim = expDist * expEdgeEffect;
+	return (expRadius + 0.001f - expDist) / (expRadius + 0.001f - expRim);
+}
+
+static bool BitEqual(float a, float b)
+{
+	return (std::memcmp(&a, &b, sizeof(float)) == 0);
+}
+
+
+
+BOOST_AUTO_TEST_CASE( BatchMatchesScalar )
+{
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> radDist(1.0f, 1024.0f);
+	std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+
+	std::vector<float> dists;
+	std::vector<float> mods;
+
+	size_t numChecked = 0;
+	size_t numMismatches = 0;
+
+	for (size_t n = 0; n < NUM_EXPLOSIONS; n++) {
+		const float expRadius = radDist(rng);
+		const float expEdgeEffect = ((n % 8) == 0)? ((n % 16) == 0)? 0.0f: 1.0f: unitDist(rng);
+
+		// odd counts exercise the scalar tail
+		dists.resize(1 + rng() % 67);
+		mods.resize(dists.size());
+
+		for (float& d: dists) {
+			// include objects outside the radius, at the center and on the rim
+			switch (rng() % 8) {
+				case  0: { d = 0.0f; } break;
+				case  1: { d = expRadius; } break;
+				case  2: { d = expRadius * (1.0f + unitDist(rng)); } break;
+				default: { d = expRadius * unitDist(rng); } break;
+			}
+		}
+
+		ExplosionFalloff::CalcDistanceMods(dists.data(), mods.data(), dists.size(), expRadius, expEdgeEffect);
+
+		for (size_t i = 0; i < dists.size(); i++) {
+			// only in-range distances are ever used
+			if (dists[i] > expRadius)
+				continue;
+
+			numChecked += 1;
+			numMismatches += !BitEqual(mods[i], ReferenceDistanceMod(expRadius, dists[i], expEdgeEffect));
+			numMismatches += !BitEqual(mods[i], ExplosionFalloff::CalcDistanceMod(expRadius, dists[i], expEdgeEffect));
+		}
+	}
+
+	LOG("[%s] checked %u falloff values", __func__, unsigned(numChecked));
+
+	BOOST_CHECK(numChecked > 0);
+	BOOST_CHECK_EQUAL(numMismatches, 0);
+}
+
+BOOST_AUTO_TEST_CASE( OutOfRangeIsFinite )
+{
+	// distances beyond the radius must not produce inf/nan (FP-exception builds)
+	const float dists[] = {2.0f, 1e30f, 10.0f, 1.0f, 1.001f};
+	float mods[5];
+
+	ExplosionFalloff::CalcDistanceMods(dists, mods, 5, 1.0f, 1.0f);
+
+	for (float m: mods) {
+		BOOST_CHECK(std::isfinite(m));
+	}
+}
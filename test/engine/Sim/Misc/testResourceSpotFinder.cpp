@@ -0,0 +1,310 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Sim/Misc/ResourceSpotFinder.h"
+#include "System/FastMath.h"
+#include "System/Log/ILog.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_MODULE ResourceSpotFinder
+#include <boost/test/unit_test.hpp>
+
+static constexpr int MAX_SPOTS = 10000;
+static constexpr int MIN_INCOME_FOR_SPOT = 50;
+
+
+struct TestMap {
+	int width;
+	int height;
+	int radius;
+
+	std::vector<unsigned char> resources;
+};
+
+
+// the original CResourceMapAnalyzer::GetResourcePoints algorithm
+// (sliding extractor sums, full rescans when the best-list runs out)
+static void ReferenceFindSpots(const TestMap& map, std::vector<CResourceSpotFinder::Spot>& spots)
+{
+	const int mapWidth = map.width;
+	const int mapHeight = map.height;
+	const int totalCells = mapWidth * mapHeight;
+	const int xtractorRadius = map.radius;
+	const int doubleRadius = xtractorRadius * 2;
+	const int squareRadius = xtractorRadius * xtractorRadius;
+
+	std::vector<unsigned char> rexArrayA(map.resources);
+	std::vector<unsigned char> rexArrayB(totalCells);
+	std::vector<int> tempAverage(totalCells);
+	std::vector<int> xend(doubleRadius + 1);
+
+	for (int a = 0; a < doubleRadius + 1; a++) {
+		float z = a - xtractorRadius;
+		float floatsqrradius = squareRadius;
+		xend[a] = int(math::sqrt(floatsqrradius - z * z));
+	}
+
+	int maxResource = 0;
+
+	const auto CalcCell = [&](int x, int y) {
+		int totalResources = 0;
+
+		if (x == 0 && y == 0) {
+			for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
+				if (sy >= 0 && sy < mapHeight) {
+					for (int sx = x - xend[a]; sx <= x + xend[a]; sx++) {
+						if (sx >= 0 && sx < mapWidth)
+							totalResources += rexArrayA[sy * mapWidth + sx];
+					}
+				}
+			}
+		}
+
+		if (x > 0) {
+			totalResources = tempAverage[y * mapWidth + x - 1];
+
+			for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
+				if (sy >= 0 && sy < mapHeight) {
+					const int addX = x + xend[a];
+					const int remX = x - xend[a] - 1;
+
+					if (addX < mapWidth)
+						totalResources += rexArrayA[sy * mapWidth + addX];
+					if (remX >= 0)
+						totalResources -= rexArrayA[sy * mapWidth + remX];
+				}
+			}
+		} else if (y > 0) {
+			totalResources = tempAverage[(y - 1) * mapWidth];
+
+			for (int sx = 0, a = xtractorRadius; sx <= xtractorRadius;  sx++, a++) {
+				if (sx < mapWidth) {
+					const int remY = y - xend[a] - 1;
+
+					if (remY >= 0)
+						totalResources -= rexArrayA[remY * mapWidth + sx];
+				}
+			}
+
+			for (int sx = 0, a = xtractorRadius; sx <= xtractorRadius;  sx++, a++) {
+				if (sx < mapWidth) {
+					const int addY = y + xend[a];
+
+					if (addY < mapHeight)
+						totalResources += rexArrayA[addY * mapWidth + sx];
+				}
+			}
+		}
+
+		return (tempAverage[y * mapWidth + x] = totalResources);
+	};
+
+	for (int y = 0; y < mapHeight; y++) {
+		for (int x = 0; x < mapWidth; x++) {
+			maxResource = std::max(maxResource, CalcCell(x, y));
+		}
+	}
+
+	if (maxResource == 0)
+		return;
+
+	for (int i = 0; i < totalCells; i++) {
+		rexArrayB[i] = tempAverage[i] * 255 / maxResource;
+	}
+
+	std::vector<int> valueDist(256, 0);
+	std::vector<int> bestSpotList;
+
+	int bestValue = 0;
+	int numberOfValues = 0;
+	int usedSpots = 0;
+
+	const auto FillBestSpotList = [&]() {
+		std::fill(valueDist.begin(), valueDist.end(), 0);
+
+		for (int i = 0; i < totalCells; i++) {
+			valueDist[rexArrayB[i]]++;
+		}
+
+		bestValue = 0;
+		numberOfValues = 0;
+		usedSpots = 0;
+
+		for (int i = 255; i >= 0; i--) {
+			if (valueDist[i] != 0) {
+				bestValue = i;
+				numberOfValues = valueDist[i];
+				break;
+			}
+		}
+
+		numberOfValues = std::min(numberOfValues, 256);
+
+		bestSpotList.clear();
+		bestSpotList.resize(numberOfValues);
+
+		for (int i = 0; i < totalCells; i++) {
+			if (rexArrayB[i] == bestValue) {
+				bestSpotList[usedSpots++] = i;
+
+				if (usedSpots == numberOfValues) {
+					usedSpots = 0;
+					break;
+				}
+			}
+		}
+	};
+
+	FillBestSpotList();
+
+	for (int n = 0; n < MAX_SPOTS; n++) {
+		int spotIndex = 0;
+
+		while (true) {
+			if (usedSpots == numberOfValues)
+				FillBestSpotList();
+
+			spotIndex = bestSpotList[usedSpots++];
+
+			if (rexArrayB[spotIndex] == bestValue)
+				break;
+		}
+
+		if (bestValue < MIN_INCOME_FOR_SPOT)
+			break;
+
+		const int coordX = spotIndex % mapWidth;
+		const int coordZ = spotIndex / mapWidth;
+
+		spots.push_back({coordX, coordZ, bestValue});
+
+		for (int sy = coordZ - xtractorRadius, a = 0;  sy <= coordZ + xtractorRadius;  sy++, a++) {
+			if (sy >= 0 && sy < mapHeight) {
+				const int clearXStart = std::max(coordX - xend[a], 0);
+				const int clearXEnd = std::min(coordX + xend[a], mapWidth - 1);
+
+				for (int xClear = clearXStart; xClear <= clearXEnd; xClear++) {
+					rexArrayA[sy * mapWidth + xClear] = 0;
+					rexArrayB[sy * mapWidth + xClear] = 0;
+					tempAverage[sy * mapWidth + xClear] = 0;
+				}
+			}
+		}
+
+		for (int y = coordZ - doubleRadius; y <= coordZ + doubleRadius; y++) {
+			if (y < 0 || y >= mapHeight)
+				continue;
+
+			for (int x = coordX - doubleRadius; x <= coordX + doubleRadius; x++) {
+				if (x < 0 || x >= mapWidth)
+					continue;
+
+				rexArrayB[y * mapWidth + x] = CalcCell(x, y) * 255 / maxResource;
+			}
+		}
+	}
+}
+
+
+
+// a few scattered clusters of metal patches, like most regular maps
+static TestMap MakeClusterMap(int width, int height, int radius, unsigned int seed)
+{
+	TestMap map = {width, height, radius, std::vector<unsigned char>(width * height, 0)};
+	std::mt19937 rng(seed);
+
+	for (int n = 0; n < (width * height) / 256; n++) {
+		const int cx = rng() % width;
+		const int cz = rng() % height;
+		const int size = 1 + rng() % 3;
+		const unsigned char value = 128 + rng() % 128;
+
+		for (int z = std::max(cz - size, 0); z <= std::min(cz + size, height - 1); z++) {
+			for (int x = std::max(cx - size, 0); x <= std::min(cx + size, width - 1); x++) {
+				map.resources[z * width + x] = value;
+			}
+		}
+	}
+
+	return map;
+}
+
+// metal everywhere (speed-metal); lots of ties
+static TestMap MakeUniformMap(int width, int height, int radius)
+{
+	return {width, height, radius, std::vector<unsigned char>(width * height, 255)};
+}
+
+static TestMap MakeNoiseMap(int width, int height, int radius, unsigned int seed)
+{
+	TestMap map = {width, height, radius, std::vector<unsigned char>(width * height, 0)};
+	std::mt19937 rng(seed);
+
+	for (unsigned char& c: map.resources) {
+		c = ((rng() % 4) == 0)? rng() % 256: 0;
+	}
+
+	return map;
+}
+
+
+static void CompareSpots(const TestMap& map, const char* name)
+{
+	std::vector<CResourceSpotFinder::Spot> refSpots;
+	std::vector<CResourceSpotFinder::Spot> newSpots;
+
+	const auto t0 = std::chrono::high_resolution_clock::now();
+	ReferenceFindSpots(map, refSpots);
+	const auto t1 = std::chrono::high_resolution_clock::now();
+
+	CResourceSpotFinder spotFinder;
+	spotFinder.Init(map.resources.data(), map.width, map.height, map.radius);
+	spotFinder.FindSpots(MAX_SPOTS, MIN_INCOME_FOR_SPOT, newSpots);
+
+	const auto t2 = std::chrono::high_resolution_clock::now();
+
+	const auto refTime = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+	const auto newTime = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+
+	LOG("[%s] %dx%d r=%d: %u spots, reference %ldus, finder %ldus", name, map.width, map.height, map.radius, unsigned(newSpots.size()), long(refTime), long(newTime));
+
+	BOOST_CHECK_EQUAL(refSpots.size(), newSpots.size());
+
+	for (size_t i = 0, n = std::min(refSpots.size(), newSpots.size()); i < n; i++) {
+		BOOST_CHECK_EQUAL(refSpots[i].x, newSpots[i].x);
+		BOOST_CHECK_EQUAL(refSpots[i].z, newSpots[i].z);
+		BOOST_CHECK_EQUAL(refSpots[i].value, newSpots[i].value);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE( ClusterMaps )
+{
+	CompareSpots(MakeClusterMap(256, 256, 6, 1), "cluster");
+	CompareSpots(MakeClusterMap(512, 384, 12, 2), "cluster");
+	CompareSpots(MakeClusterMap(97, 131, 3, 3), "cluster");
+}
+
+BOOST_AUTO_TEST_CASE( UniformMaps )
+{
+	CompareSpots(MakeUniformMap(128, 128, 4), "uniform");
+	CompareSpots(MakeUniformMap(200, 75, 7), "uniform");
+}
+
+BOOST_AUTO_TEST_CASE( NoiseMaps )
+{
+	CompareSpots(MakeNoiseMap(256, 256, 5, 4), "noise");
+	CompareSpots(MakeNoiseMap(64, 300, 9, 5), "noise");
+}
+
+BOOST_AUTO_TEST_CASE( DegenerateMaps )
+{
+	// footprint larger than the map, zero radius, single cell, no resources
+	CompareSpots(MakeClusterMap(16, 16, 40, 6), "tiny");
+	CompareSpots(MakeNoiseMap(64, 64, 0, 7), "point");
+	CompareSpots(MakeUniformMap(1, 1, 2), "single");
+	CompareSpots({32, 32, 4, std::vector<unsigned char>(32 * 32, 0)}, "empty");
+}
@@ -0,0 +1,148 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Sim/Misc/SimObjectMemPool.h"
+#include "System/Log/ILog.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#define BOOST_TEST_MODULE SimObjectMemPool
+#include <boost/test/unit_test.hpp>
+
+// roughly the size of a typical projectile
+static constexpr size_t PAGE_SIZE = 1024;
+
+static constexpr size_t NUM_LIVE_OBJECTS = 4096;
+static constexpr size_t NUM_CHURN_ITERS = 1 << 20;
+
+
+struct Base {
+	virtual ~Base() {}
+	uint32_t id = 0;
+};
+
+struct Projectile: public Base {
+	Projectile(uint32_t i) { id = i; }
+	~Projectile() { std::memset(payload, 0xFF, sizeof(payload)); }
+
+	uint8_t payload[512];
+};
+
+// a plain block of bytes; filled with a pattern by the test
+struct RawBlock {
+	RawBlock() {}
+
+	uint8_t bytes[PAGE_SIZE / 2];
+};
+
+
+
+template<typename Pool> static void ChurnPool(Pool& pool, const char* name)
+{
+	std::mt19937 rng(12345);
+	std::vector<Base*> objects;
+
+	objects.reserve(NUM_LIVE_OBJECTS);
+
+	for (size_t n = 0; n < NUM_LIVE_OBJECTS; n++) {
+		objects.push_back(pool.template alloc<Projectile>(n));
+	}
+
+	BOOST_CHECK(pool.live_size() == NUM_LIVE_OBJECTS * PAGE_SIZE);
+	BOOST_CHECK(pool.freed_size() == 0);
+
+	const auto t0 = std::chrono::high_resolution_clock::now();
+
+	// projectile spam: each iteration kills a random object and
+	// immediately spawns a replacement, reusing the freed page
+	for (size_t n = 0; n < NUM_CHURN_ITERS; n++) {
+		const size_t i = rng() % objects.size();
+
+		pool.free(objects[i]);
+		objects[i] = pool.template alloc<Projectile>(n);
+	}
+
+	const auto t1 = std::chrono::high_resolution_clock::now();
+	const auto dt = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+
+	LOG("[%s] %u alloc/free pairs: %.2fns per pair (occupancy=%.2f)", name, unsigned(NUM_CHURN_ITERS), dt * 1.0f / NUM_CHURN_ITERS, pool.occupancy());
+
+	// churn must not grow the pool
+	BOOST_CHECK(pool.alloc_size() == NUM_LIVE_OBJECTS * PAGE_SIZE);
+	BOOST_CHECK(pool.occupancy() == 1.0f);
+
+	// release half the objects to create holes; free() nulls the
+	// pointers, so remember which pages were released beforehand
+	std::set<const void*> freedPages;
+
+	for (size_t n = 0; n < NUM_LIVE_OBJECTS; n += 2) {
+		freedPages.insert(objects[n]);
+		pool.free(objects[n]);
+	}
+
+	BOOST_CHECK(pool.live_size() == (NUM_LIVE_OBJECTS / 2) * PAGE_SIZE);
+	BOOST_CHECK(pool.occupancy() == 0.5f);
+
+	// the holes must be refilled without growing the pool, by distinct
+	// and suitably aligned pages that do not overlap any live object
+	std::vector<RawBlock*> blocks;
+
+	for (size_t n = 0; n < NUM_LIVE_OBJECTS; n += 2) {
+		RawBlock* b = pool.template alloc<RawBlock>();
+
+		BOOST_CHECK((reinterpret_cast<uintptr_t>(b) % alignof(RawBlock)) == 0);
+		BOOST_CHECK(pool.alloced(b));
+		BOOST_CHECK(pool.mapped(b));
+		BOOST_CHECK(freedPages.erase(b) == 1);
+
+		std::memset(b->bytes, int(n & 0xFF), sizeof(b->bytes));
+		blocks.push_back(b);
+	}
+
+	BOOST_CHECK(freedPages.empty());
+	BOOST_CHECK(pool.alloc_size() == NUM_LIVE_OBJECTS * PAGE_SIZE);
+
+	for (size_t n = 0; n < blocks.size(); n++) {
+		bool intact = true;
+
+		for (size_t k = 0; k < sizeof(blocks[n]->bytes); k++) {
+			intact &= (blocks[n]->bytes[k] == ((n * 2) & 0xFF));
+		}
+
+		BOOST_CHECK(intact);
+		pool.free(blocks[n]);
+	}
+
+	for (size_t n = 1; n < NUM_LIVE_OBJECTS; n += 2) {
+		// would have been clobbered by an overlapping block
+		BOOST_CHECK(objects[n]->id < NUM_CHURN_ITERS);
+		BOOST_CHECK(pool.mapped(objects[n]));
+		pool.free(objects[n]);
+	}
+
+	BOOST_CHECK(pool.live_size() == 0);
+	BOOST_CHECK(pool.freed_size() == pool.alloc_size());
+}
+
+
+
+BOOST_AUTO_TEST_CASE( DynMemPoolChurn )
+{
+	DynMemPool<PAGE_SIZE> pool;
+	pool.reserve(NUM_LIVE_OBJECTS);
+
+	ChurnPool(pool, "DynMemPool");
+}
+
+BOOST_AUTO_TEST_CASE( StaticMemPoolChurn )
+{
+	// large, keep off the stack
+	std::unique_ptr< StaticMemPool<NUM_LIVE_OBJECTS, PAGE_SIZE> > pool(new StaticMemPool<NUM_LIVE_OBJECTS, PAGE_SIZE>());
+
+	ChurnPool(*pool.get(), "StaticMemPool");
+}
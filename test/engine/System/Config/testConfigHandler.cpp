@@ -0,0 +1,117 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "System/Config/ConfigHandler.h"
+#include "System/Config/ConfigLocater.h"
+#include "System/Log/ILog.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#define BOOST_TEST_MODULE ConfigHandler
+#include <boost/test/unit_test.hpp>
+
+static constexpr int NUM_BENCH_ITERS = 1 << 20;
+
+
+CONFIG(int, TestCachedInt).defaultValue(7).minimumValue(0).maximumValue(100);
+CONFIG(float, TestCachedFloat).defaultValue(0.25f);
+CONFIG(bool, TestCachedBool).defaultValue(false);
+CONFIG(std::string, TestCachedString).defaultValue("a b c");
+
+CONFIG_VALUE(int, TestCachedInt);
+CONFIG_VALUE(float, TestCachedFloat);
+CONFIG_VALUE(bool, TestCachedBool);
+CONFIG_VALUE(std::string, TestCachedString);
+
+
+// only used by Instantiate when no explicit source is given
+void ConfigLocater::GetDefaultLocations(std::vector<std::string>& locations) {}
+
+
+struct ConfigFixture {
+	ConfigFixture(): fileName("testConfigHandler.cfg") { ConfigHandler::Instantiate(fileName); }
+	~ConfigFixture() { ConfigHandler::Deallocate(); std::remove(fileName.c_str()); }
+
+	std::string fileName;
+};
+
+
+
+BOOST_FIXTURE_TEST_CASE( CachedValues, ConfigFixture )
+{
+	// resolved on instantiation
+	BOOST_CHECK(cfgValueTestCachedInt.Get() == 7);
+	BOOST_CHECK(cfgValueTestCachedFloat.Get() == 0.25f);
+	BOOST_CHECK(cfgValueTestCachedBool.Get() == false);
+	BOOST_CHECK(cfgValueTestCachedString.Get() == "a b c");
+
+	// refreshed immediately on Set, no Update needed
+	configHandler->Set("TestCachedInt", 42);
+	configHandler->Set("TestCachedFloat", 1.5f);
+	configHandler->Set("TestCachedBool", true);
+	configHandler->SetString("TestCachedString", "x y");
+
+	BOOST_CHECK(cfgValueTestCachedInt.Get() == configHandler->GetInt("TestCachedInt"));
+	BOOST_CHECK(cfgValueTestCachedFloat.Get() == configHandler->GetFloat("TestCachedFloat"));
+	BOOST_CHECK(cfgValueTestCachedBool.Get() == configHandler->GetBool("TestCachedBool"));
+	BOOST_CHECK(cfgValueTestCachedString.Get() == configHandler->GetString("TestCachedString"));
+	BOOST_CHECK(cfgValueTestCachedInt.Get() == 42);
+
+	// clamped like GetInt
+	configHandler->Set("TestCachedInt", 1000);
+	BOOST_CHECK(cfgValueTestCachedInt.Get() == 100);
+
+	// overlay values are seen too
+	configHandler->Set("TestCachedInt", 3, true);
+	BOOST_CHECK(cfgValueTestCachedInt.Get() == 3);
+
+	// falls back to the default
+	configHandler->Delete("TestCachedInt");
+	BOOST_CHECK(cfgValueTestCachedInt.Get() == 7);
+}
+
+BOOST_FIXTURE_TEST_CASE( CachedValuesOverlayThenPersist, ConfigFixture )
+{
+	configHandler->Set("TestCachedInt", 42);
+	configHandler->Set("TestCachedInt", 3, true);
+	BOOST_CHECK(cfgValueTestCachedInt.Get() == 3);
+
+	// persisting the already persisted value drops the overlay
+	configHandler->Set("TestCachedInt", 42);
+	BOOST_CHECK(configHandler->GetInt("TestCachedInt") == 42);
+	BOOST_CHECK(cfgValueTestCachedInt.Get() == 42);
+
+	// same for strings, and for persisting the default
+	configHandler->SetString("TestCachedString", "x y", true);
+	BOOST_CHECK(cfgValueTestCachedString.Get() == "x y");
+
+	configHandler->SetString("TestCachedString", "a b c");
+	BOOST_CHECK(cfgValueTestCachedString.Get() == "a b c");
+	BOOST_CHECK(cfgValueTestCachedString.Get() == configHandler->GetString("TestCachedString"));
+}
+
+BOOST_FIXTURE_TEST_CASE( CachedValueThroughput, ConfigFixture )
+{
+	int sum[2] = {0, 0};
+
+	const auto t0 = std::chrono::high_resolution_clock::now();
+
+	for (int n = 0; n < NUM_BENCH_ITERS; n++) {
+		sum[0] += configHandler->GetInt("TestCachedInt");
+	}
+
+	const auto t1 = std::chrono::high_resolution_clock::now();
+
+	for (int n = 0; n < NUM_BENCH_ITERS; n++) {
+		sum[1] += *static_cast<const volatile int*>(&cfgValueTestCachedInt.Get());
+	}
+
+	const auto t2 = std::chrono::high_resolution_clock::now();
+	const auto dt0 = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+	const auto dt1 = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+
+	LOG("[CachedValueThroughput] GetInt: %.2fns per read, ConfigValue: %.2fns per read", dt0 * 1.0f / NUM_BENCH_ITERS, dt1 * 1.0f / NUM_BENCH_ITERS);
+
+	BOOST_CHECK(sum[0] == sum[1]);
+}
@@ -2,6 +2,8 @@
 
 #include "System/creg/creg_cond.h"
 #include "System/creg/Serializer.h"
+#include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -78,6 +80,30 @@ CR_REG_METADATA(TestObj, (
 ));
 
 
+// POD-heavy object, stands in for heightmaps and LOS maps
+struct BulkObj {
+	CR_DECLARE(BulkObj);
+
+	BulkObj() {}
+	virtual ~BulkObj() {}
+
+	std::vector<float> heights;
+	std::vector<std::uint16_t> losMap;
+	std::vector<std::uint8_t> typeMap;
+	std::vector<EnumClass> enums;
+	float matrix[16];
+};
+
+CR_BIND(BulkObj, );
+CR_REG_METADATA(BulkObj, (
+	CR_MEMBER(heights),
+	CR_MEMBER(losMap),
+	CR_MEMBER(typeMap),
+	CR_MEMBER(enums),
+	CR_MEMBER(matrix)
+));
+
+
 static void savetest(std::ostream* os)
 {
 	// root obj
@@ -170,3 +196,56 @@ BOOST_AUTO_TEST_CASE( BOOST_TEST_MODULE )
 
 	delete root;
 }
+
+
+
+BOOST_AUTO_TEST_CASE( BulkArrays )
+{
+	static const int MAP_SIZE = 1024 * 1024;
+
+	BulkObj* o = new BulkObj();
+
+	o->heights.resize(MAP_SIZE);
+	o->losMap.resize(MAP_SIZE);
+	o->typeMap.resize(MAP_SIZE);
+	o->enums.resize(1000);
+
+	for (int i = 0; i < MAP_SIZE; i++) {
+		o->heights[i] = (i % 4096) * 0.25f - 100.0f;
+		o->losMap[i] = i * 7;
+		o->typeMap[i] = i * 13;
+	}
+	for (int i = 0; i < 1000; i++) {
+		o->enums[i] = EnumClass(i % 4);
+	}
+	for (int i = 0; i < 16; i++) {
+		o->matrix[i] = i * 0.5f;
+	}
+
+	std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+
+	const auto t0 = std::chrono::high_resolution_clock::now();
+	{
+		creg::COutputStreamSerializer os;
+		os.SavePackage(&ss, o, o->GetClass());
+	}
+	const auto t1 = std::chrono::high_resolution_clock::now();
+
+	BulkObj* root = (BulkObj*)loadtest(&ss);
+
+	const auto t2 = std::chrono::high_resolution_clock::now();
+
+	BOOST_TEST_MESSAGE("save: " << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << "ms, "
+	                << "load: " << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << "ms, "
+	                << "size: " << (ss.str().size() >> 10) << "KB");
+
+	BOOST_REQUIRE(dynamic_cast<BulkObj*>(root));
+	BOOST_CHECK(root->heights == o->heights);
+	BOOST_CHECK(root->losMap == o->losMap);
+	BOOST_CHECK(root->typeMap == o->typeMap);
+	BOOST_CHECK(root->enums == o->enums);
+	BOOST_CHECK(std::equal(o->matrix, o->matrix + 16, root->matrix));
+
+	delete root;
+	delete o;
+}
@@ -3,13 +3,19 @@
 //TODO rewrite most of this file atm it's more a verbose debug tool than a UnitTest
 
 #include "ExternalAI/Interface/SSkirmishAILibrary.h"
+#include "../tools/unitsync/MapCache.h"
 #include "System/Option.h"
 #include "System/Log/ILog.h"
 #include "System/VersionGenerated.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#ifndef _WIN32
+	#include <dirent.h>
+	#include <sys/stat.h>
+#endif
 
+#include <algorithm>
 #include <string>
 #include <vector>
 //#include <future>
@@ -221,6 +227,64 @@ static bool TestLuaParser()
 /******************************************************************************/
 /******************************************************************************/
 
+/**
+ * Removes the ProcessUnits items from the unitsync cache if <clear>,
+ * returns how many there were (and their paths if <items> is given).
+ */
+static int CountCachedUnitDefs(const string& cacheDir, bool clear, std::vector<string>* items = NULL)
+{
+	int count = 0;
+
+#ifndef _WIN32
+	DIR* dir = opendir(cacheDir.c_str());
+
+	if (dir == NULL)
+		return 0;
+
+	const string suffix = ".unitdefs";
+
+	for (const dirent* ent = readdir(dir); ent != NULL; ent = readdir(dir)) {
+		const string name = ent->d_name;
+
+		if (name.size() <= suffix.size() || name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+			continue;
+
+		if (clear)
+			remove((cacheDir + name).c_str());
+		if (items != NULL)
+			items->push_back(cacheDir + name);
+
+		count++;
+	}
+
+	closedir(dir);
+#endif
+
+	return count;
+}
+
+
+static std::vector<string> GetUnitNames()
+{
+	std::vector<string> names(std::max(us::GetUnitCount(), 0));
+
+	for (size_t i = 0; i < names.size(); i++) {
+		names[i] = us::GetUnitName(i);
+	}
+
+	return names;
+}
+
+static void AddPrimaryModArchives(int gameidx)
+{
+	const int archiveCount = us::GetPrimaryModArchiveCount(gameidx);
+
+	for (int i = 0; i < archiveCount; i++) {
+		us::AddArchive(us::GetPrimaryModArchiveList(i));
+	}
+}
+
+
 static std::string GetGameName(int gameidx)
 {
 	const int infocount = us::GetPrimaryModInfoCount(gameidx);
@@ -313,6 +377,53 @@ BOOST_AUTO_TEST_CASE( UnitSync )
 		BOOST_CHECK_MESSAGE((errmsg = us::GetNextError()) == NULL, errmsg);
 		BOOST_CHECK(us::GetUnitCount() >= 1);
 		BOOST_CHECK(us::GetSideCount() >= 1);
+
+		// the same game added archive by archive must be cacheable as well
+		// (ProcessUnits only writes the cache if the archive-set key != 0)
+		const string cacheDir = string(us::GetWritableDataDirectory()) + "cache/unitsync/";
+		CountCachedUnitDefs(cacheDir, true);
+
+		us::RemoveAllArchives();
+		AddPrimaryModArchives(gameidx);
+
+		BOOST_CHECK_MESSAGE((errmsg = us::GetNextError()) == NULL, errmsg);
+		BOOST_CHECK(us::ProcessUnits() == 0);
+		BOOST_CHECK_MESSAGE((errmsg = us::GetNextError()) == NULL, errmsg);
+		BOOST_CHECK(us::GetUnitCount() >= 1);
+
+		const std::vector<string> coldNames = GetUnitNames();
+
+#ifndef _WIN32
+		std::vector<string> cacheItems;
+		struct stat coldStat;
+
+		BOOST_CHECK(CountCachedUnitDefs(cacheDir, false, &cacheItems) == 1);
+		BOOST_REQUIRE(!cacheItems.empty() && stat(cacheItems[0].c_str(), &coldStat) == 0);
+#endif
+
+		// a fresh instance has nothing processed, so the same archive set
+		// has to be served from the cache written by the cold run above
+		us::UnInit();
+		BOOST_CHECK(us::Init(false, 0) != 0);
+		AddPrimaryModArchives(gameidx);
+
+		BOOST_CHECK_MESSAGE((errmsg = us::GetNextError()) == NULL, errmsg);
+		BOOST_CHECK(us::ProcessUnits() == 0);
+		BOOST_CHECK_MESSAGE((errmsg = us::GetNextError()) == NULL, errmsg);
+
+		const std::vector<string> warmNames = GetUnitNames();
+
+		BOOST_CHECK(warmNames.size() == coldNames.size());
+		BOOST_CHECK(warmNames == coldNames);
+
+#ifndef _WIN32
+		// a cache miss would have replaced the item (written via rename)
+		struct stat warmStat;
+
+		BOOST_CHECK(CountCachedUnitDefs(cacheDir, false) == 1);
+		BOOST_CHECK(stat(cacheItems[0].c_str(), &warmStat) == 0);
+		BOOST_CHECK(warmStat.st_ino == coldStat.st_ino);
+#endif
 	}
 
 	// VFS
@@ -342,3 +453,40 @@ BOOST_AUTO_TEST_CASE( UnitSync )
 	BOOST_CHECK(us::GetWritableDataDirectory() == NULL);
 	BOOST_CHECK_MESSAGE((errmsg = us::GetNextError()) != NULL, errmsg);
 }
+
+
+BOOST_AUTO_TEST_CASE( UnitDefsCacheKey )
+{
+	const std::string version = "104.0";
+
+	std::vector< std::pair<unsigned int, bool> > checksums = {{0x12345678, true}, {0x9abcdef0, false}};
+
+	const unsigned int key = GetUnitDefsCacheKey(version, checksums);
+
+	BOOST_CHECK(key != 0);
+	BOOST_CHECK(key == GetUnitDefsCacheKey(version, checksums));
+
+	// any changed archive has to miss the cache
+	checksums[1].first ^= 1;
+	BOOST_CHECK(key != GetUnitDefsCacheKey(version, checksums));
+	checksums[1].first ^= 1;
+
+	checksums[0].first += 1;
+	BOOST_CHECK(key != GetUnitDefsCacheKey(version, checksums));
+	checksums[0].first -= 1;
+
+	// so does a different engine or a different way of adding the archives
+	BOOST_CHECK(key != GetUnitDefsCacheKey("104.0.1", checksums));
+
+	checksums[1].second = true;
+	BOOST_CHECK(key != GetUnitDefsCacheKey(version, checksums));
+	checksums[1].second = false;
+
+	std::swap(checksums[0], checksums[1]);
+	BOOST_CHECK(key != GetUnitDefsCacheKey(version, checksums));
+
+	// unidentifiable archive sets are never cached
+	checksums[0].first = 0;
+	BOOST_CHECK(GetUnitDefsCacheKey(version, checksums) == 0);
+	BOOST_CHECK(GetUnitDefsCacheKey(version, {}) == 0);
+}
@@ -0,0 +1,158 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "MapCache.h"
+#include "System/CRC.h"
+#include "System/Log/ILog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+CMapCache mapCache;
+
+
+// bump whenever the layout of any cached item changes
+static constexpr std::uint32_t CACHE_VERSION = 2;
+
+// followed by <nameSize> bytes of name and <size> bytes of data
+struct CacheItemHeader {
+	char magic[4];
+	std::uint32_t version;
+	std::uint32_t checksum;
+	std::uint32_t nameSize;
+	std::uint32_t size;
+};
+
+static constexpr char CACHE_MAGIC[4] = {'U', 'S', 'M', 'C'};
+
+
+// several unitsync instances (lobbies, tools) can share one cache directory,
+// each writer needs its own temporary file
+static std::string GetTempFileSuffix()
+{
+	static const std::uint64_t instanceID = std::random_device()() ^ std::chrono::steady_clock::now().time_since_epoch().count();
+	static std::atomic<std::uint32_t> counter = {0};
+
+	char buf[48];
+	snprintf(buf, sizeof(buf), ".%016llx.%08x.tmp", static_cast<unsigned long long>(instanceID), counter.fetch_add(1));
+	return buf;
+}
+
+
+std::string CMapCache::GetItemPath(unsigned int checksum, const std::string& item) const
+{
+	char buf[16];
+	snprintf(buf, sizeof(buf), "%08x.", checksum);
+	return (cacheDir + buf + item);
+}
+
+
+bool CMapCache::Read(unsigned int checksum, const std::string& name, const std::string& item, std::vector<std::uint8_t>& data) const
+{
+	if (!IsEnabled())
+		return false;
+
+	std::ifstream ifs(GetItemPath(checksum, item), std::ios::in | std::ios::binary);
+
+	if (!ifs.is_open())
+		return false;
+
+	CacheItemHeader header;
+
+	if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return false;
+
+	if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+		return false;
+	if (header.version != CACHE_VERSION || header.checksum != checksum)
+		return false;
+	if (header.nameSize != name.size())
+		return false;
+
+	std::string itemName(name.size(), 0);
+
+	if (!name.empty() && !ifs.read(&itemName[0], name.size()))
+		return false;
+
+	// checksums are only 32 bits, make sure this is really our item
+	if (itemName != name)
+		return false;
+
+	data.resize(header.size);
+
+	// a truncated item (e.g. disk full while writing) counts as a miss
+	if (header.size > 0 && !ifs.read(reinterpret_cast<char*>(data.data()), header.size)) {
+		data.clear();
+		return false;
+	}
+
+	return true;
+}
+
+
+void CMapCache::Write(unsigned int checksum, const std::string& name, const std::string& item, const void* data, size_t size) const
+{
+	if (!IsEnabled())
+		return;
+
+	const std::string itemPath = GetItemPath(checksum, item);
+	const std::string tempPath = itemPath + GetTempFileSuffix();
+
+	{
+		std::ofstream ofs(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (!ofs.is_open()) {
+			LOG_L(L_WARNING, "[MapCache::%s] could not open \"%s\" for writing", __func__, tempPath.c_str());
+			return;
+		}
+
+		CacheItemHeader header;
+		std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+		header.version = CACHE_VERSION;
+		header.checksum = checksum;
+		header.nameSize = name.size();
+		header.size = size;
+
+		ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		ofs.write(name.data(), name.size());
+		ofs.write(reinterpret_cast<const char*>(data), size);
+
+		if (!ofs.good()) {
+			ofs.close();
+			std::remove(tempPath.c_str());
+			return;
+		}
+	}
+
+	// rename does not replace existing files on Windows
+	std::remove(itemPath.c_str());
+
+	if (std::rename(tempPath.c_str(), itemPath.c_str()) != 0)
+		std::remove(tempPath.c_str());
+}
+
+
+
+unsigned int GetUnitDefsCacheKey(const std::string& syncVersion, const std::vector< std::pair<unsigned int, bool> >& archiveChecksums)
+{
+	if (archiveChecksums.empty())
+		return 0;
+
+	CRC crc;
+	crc.Update(syncVersion.data(), syncVersion.size());
+
+	for (const auto& p: archiveChecksums) {
+		if (p.first == 0)
+			return 0;
+
+		crc.Update(p.first);
+		crc.Update(p.second);
+	}
+
+	// never collide with the "nothing cached" value
+	return std::max(crc.GetDigest(), 1u);
+}
@@ -0,0 +1,77 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef UNITSYNC_MAP_CACHE_H
+#define UNITSYNC_MAP_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Persistent on-disk cache for per-map data served by unitsync
+ *
+ * Stores map meta-data, decoded minimaps and info-maps so that repeated
+ * queries (e.g. from a lobby refreshing its map list) do not have to open
+ * and parse the map archive again.
+ *
+ * Items are keyed by the complete archive checksum of the map (including
+ * its dependencies) as computed by CArchiveScanner, which means a changed
+ * archive automatically misses the cache; entries for checksums that are
+ * no longer installed are simply never read again.
+ * Every item lives in its own file "<dir>/<checksum>.<item>"; the file also
+ * stores the name it was written for (e.g. the map name), which Read has to
+ * match, so that two archives whose checksums collide can not share items.
+ *
+ * ProcessUnits stores its results here as well, keyed by a checksum over
+ * the whole set of archives it was run on.
+ */
+class CMapCache
+{
+public:
+	/// @param dir absolute, writable directory (with trailing separator); empty disables the cache
+	void SetDirectory(const std::string& dir) { cacheDir = dir; }
+
+	bool IsEnabled() const { return !cacheDir.empty(); }
+
+	/**
+	 * @brief Read a cached item
+	 * @param name what the item was written for, must match the one given to Write
+	 * @return false if caching is disabled, the item does not exist, belongs to
+	 * another name or is corrupt
+	 */
+	bool Read(unsigned int checksum, const std::string& name, const std::string& item, std::vector<std::uint8_t>& data) const;
+
+	/**
+	 * @brief Store an item, replacing any previous version
+	 *
+	 * The file is written under a temporary name unique to this writer and
+	 * then renamed, so that concurrent unitsync instances never see (or
+	 * write into) a partially written item.
+	 */
+	void Write(unsigned int checksum, const std::string& name, const std::string& item, const void* data, size_t size) const;
+
+	void Write(unsigned int checksum, const std::string& name, const std::string& item, const std::vector<std::uint8_t>& data) const {
+		Write(checksum, name, item, data.data(), data.size());
+	}
+
+private:
+	std::string GetItemPath(unsigned int checksum, const std::string& item) const;
+
+private:
+	std::string cacheDir;
+};
+
+extern CMapCache mapCache;
+
+
+/**
+ * @brief key ProcessUnits caches its results under
+ * @param syncVersion engine sync version the results were produced by
+ * @param archiveChecksums one entry per added archive, in order: its checksum
+ * and whether that includes its dependencies (AddAllArchives)
+ * @return 0 if there are no archives or one of them could not be checksummed
+ */
+unsigned int GetUnitDefsCacheKey(const std::string& syncVersion, const std::vector< std::pair<unsigned int, bool> >& archiveChecksums);
+
+#endif // UNITSYNC_MAP_CACHE_H
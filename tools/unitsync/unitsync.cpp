@@ -2,8 +2,10 @@
 
 #include "unitsync.h"
 #include "unitsync_api.h"
+#include "MapCache.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <string>
 #include <vector>
@@ -21,11 +23,13 @@
 #include "ExternalAI/Interface/SSkirmishAILibrary.h"
 #include "ExternalAI/LuaAIImplHandler.h"
 #include "System/Config/ConfigHandler.h"
+#include "System/CRC.h"
 #include "System/FileSystem/Archives/IArchive.h"
 #include "System/FileSystem/ArchiveLoader.h"
 #include "System/FileSystem/ArchiveScanner.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/DataDirLocater.h"
+#include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/FileSystem/VFSHandler.h"
 #include "System/FileSystem/FileSystem.h"
@@ -74,6 +78,7 @@ BOOL CALLING_CONV DllMain(HINSTANCE hInst, DWORD dwReason, LPVOID lpReserved)
 
 CONFIG(bool, UnitsyncAutoUnLoadMaps).defaultValue(true).description("Automaticly load and unload the required map for some unitsync functions.");
 CONFIG(bool, UnitsyncAutoUnLoadMapsIsSupported).defaultValue(true).readOnly(true).description("Check for support of UnitsyncAutoUnLoadMaps");
+CONFIG(bool, UnitsyncMapCache).defaultValue(true).description("Keep map meta-data, minimaps and info-maps in an on-disk cache (keyed by archive checksum) so they are not re-read from the map archives.");
 
 //////////////////////////
 //////////////////////////
@@ -155,6 +160,54 @@ static std::vector<InfoItem> info;
 static std::set<std::string> infoSet;
 
 
+// (de)serialization helpers for mapCache items; the cache is local
+// to this machine, so values are stored in native byte order
+template<typename T>
+static void PushCacheValue(std::vector<std::uint8_t>& buf, const T& value)
+{
+	const std::uint8_t* p = reinterpret_cast<const std::uint8_t*>(&value);
+	buf.insert(buf.end(), p, p + sizeof(T));
+}
+
+static void PushCacheString(std::vector<std::uint8_t>& buf, const std::string& str)
+{
+	PushCacheValue<std::uint32_t>(buf, str.size());
+	buf.insert(buf.end(), str.begin(), str.end());
+}
+
+struct CacheReader {
+	CacheReader(const std::vector<std::uint8_t>& b): buf(b) {}
+
+	template<typename T> T Pop() {
+		T value = T();
+
+		if ((valid &= (pos + sizeof(T) <= buf.size()))) {
+			std::memcpy(&value, &buf[pos], sizeof(T));
+			pos += sizeof(T);
+		}
+
+		return value;
+	}
+
+	std::string PopString() {
+		const std::uint32_t size = Pop<std::uint32_t>();
+
+		if (!(valid &= (pos + size <= buf.size())))
+			return "";
+
+		pos += size;
+		return {buf.begin() + pos - size, buf.begin() + pos};
+	}
+
+	size_t Remaining() const { return (buf.size() - pos); }
+
+	const std::vector<std::uint8_t>& buf;
+
+	size_t pos = 0;
+	bool valid = true;
+};
+
+
 struct GameDataUnitDef {
 	std::string name;
 	std::string fullName;
@@ -162,6 +215,103 @@ struct GameDataUnitDef {
 
 static std::vector<GameDataUnitDef> unitDefs;
 
+// archives added to the VFS via AddArchive (false) or AddAllArchives (true), in order
+static std::vector< std::pair<std::string, bool> > addedArchives;
+// key of the archive set unitDefs was last processed for, 0 if none
+static unsigned int unitDefsKey = 0;
+
+
+/**
+ * @brief identifies the content ProcessUnits operates on
+ * @return 0 if the current archive set can not be identified
+ */
+static unsigned int GetUnitDefsCacheKey()
+{
+	std::vector< std::pair<unsigned int, bool> > checksums;
+	checksums.reserve(addedArchives.size());
+
+	for (const auto& p: addedArchives) {
+		// AddArchive stores versioned names, the scanner checksums files
+		const std::string& archive = archiveScanner->ArchiveFromName(p.first);
+
+		// checksums are cached by the scanner after the first computation
+		const unsigned int checksum = p.second?
+			archiveScanner->GetArchiveCompleteChecksum(p.first):
+			archiveScanner->GetSingleArchiveChecksum(archiveScanner->GetArchivePath(archive) + archive);
+
+		if (checksum == 0)
+			return 0;
+
+		checksums.emplace_back(checksum, p.second);
+	}
+
+	return GetUnitDefsCacheKey(SpringVersion::GetSync(), checksums);
+}
+
+/**
+ * @brief the archive set GetUnitDefsCacheKey was computed over, stored
+ * along with the cached unitdefs to tell apart sets whose keys collide
+ */
+static std::string GetUnitDefsCacheName()
+{
+	std::string name = SpringVersion::GetSync();
+
+	for (const auto& p: addedArchives) {
+		name += (p.second? "\n+": "\n");
+		name += p.first;
+	}
+
+	return name;
+}
+
+static bool ReadCachedUnitDefs(unsigned int key)
+{
+	std::vector<std::uint8_t> buf;
+
+	if (!mapCache.Read(key, GetUnitDefsCacheName(), "unitdefs", buf))
+		return false;
+
+	CacheReader reader(buf);
+
+	const std::uint32_t numUnitDefs = reader.Pop<std::uint32_t>();
+
+	// each def takes at least its two string lengths, reject counts a
+	// corrupt item could not possibly hold before allocating for them
+	if (!reader.valid || numUnitDefs > (reader.Remaining() / (sizeof(std::uint32_t) * 2)))
+		return false;
+
+	unitDefs.clear();
+	unitDefs.resize(numUnitDefs);
+
+	for (GameDataUnitDef& ud: unitDefs) {
+		ud.name = reader.PopString();
+		ud.fullName = reader.PopString();
+
+		if (!reader.valid)
+			break;
+	}
+
+	if (!reader.valid)
+		unitDefs.clear();
+
+	return reader.valid;
+}
+
+static void WriteCachedUnitDefs(unsigned int key)
+{
+	std::vector<std::uint8_t> buf;
+
+	PushCacheValue<std::uint32_t>(buf, unitDefs.size());
+
+	for (const GameDataUnitDef& ud: unitDefs) {
+		PushCacheString(buf, ud.name);
+		PushCacheString(buf, ud.fullName);
+	}
+
+	mapCache.Write(key, GetUnitDefsCacheName(), "unitdefs", buf);
+}
+
+
 void LoadGameDataUnitDefs() {
 	unitDefs.clear();
 
@@ -337,6 +487,10 @@ static void _Cleanup()
 {
 	spring::SafeDelete(unitsyncConfigObserver);
 	internal_deleteMapInfos();
+	mapCache.SetDirectory("");
+	addedArchives.clear();
+	unitDefs.clear();
+	unitDefsKey = 0;
 
 	lpClose();
 	LOG("deinitialized");
@@ -397,6 +551,14 @@ EXPORT(int) Init(bool isServer, int id)
 		CheckForImportantFilesInVFS();
 		ThreadPool::SetThreadCount(0);
 		configHandler->Set("UnitsyncAutoUnLoadMaps", true); //reset on each load (backwards compatibility)
+
+		if (configHandler->GetBool("UnitsyncMapCache")) {
+			const std::string cacheDir = dataDirsAccess.LocateDir("cache/unitsync", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+			if (FileSystem::DirIsWritable(cacheDir))
+				mapCache.SetDirectory(FileSystem::EnsurePathSepAtEnd(cacheDir));
+		}
+
 		unitsyncConfigObserver = new UnitsyncConfigObserver();
 		ret = 1;
 		LOG("[UnitSync::%s] initialized %s (call %d)", __FUNCTION__, springFull.c_str(), numCalls);
@@ -462,7 +624,23 @@ EXPORT(int) ProcessUnits()
 	try {
 		CheckInit();
 		LOG_L(L_DEBUG, "[%s] loaded=%d", __FUNCTION__, unitDefs.empty());
-		LoadGameDataUnitDefs();
+
+		const unsigned int key = GetUnitDefsCacheKey();
+
+		// same archive set as last time, nothing to do
+		if (key != 0 && key == unitDefsKey)
+			return 0;
+
+		unitDefsKey = 0;
+
+		if (key == 0 || !ReadCachedUnitDefs(key)) {
+			LoadGameDataUnitDefs();
+
+			if (key != 0)
+				WriteCachedUnitDefs(key);
+		}
+
+		unitDefsKey = key;
 	}
 	UNITSYNC_CATCH_BLOCKS;
 
@@ -517,7 +695,10 @@ EXPORT(void) AddArchive(const char* archiveName)
 		CheckNullOrEmpty(archiveName);
 
 		LOG_L(L_DEBUG, "adding archive: %s", archiveName);
-		vfsHandler->AddArchive(archiveScanner->NameFromArchive(archiveName), false);
+		const std::string& name = archiveScanner->NameFromArchive(archiveName);
+
+		vfsHandler->AddArchive(name, false);
+		addedArchives.emplace_back(name, false);
 	}
 	UNITSYNC_CATCH_BLOCKS;
 }
@@ -529,6 +710,7 @@ EXPORT(void) AddAllArchives(const char* rootArchiveName)
 		CheckInit();
 		CheckNullOrEmpty(rootArchiveName);
 		vfsHandler->AddArchiveWithDeps(rootArchiveName, false);
+		addedArchives.emplace_back(rootArchiveName, true);
 	}
 	UNITSYNC_CATCH_BLOCKS;
 }
@@ -541,6 +723,7 @@ EXPORT(void) RemoveAllArchives()
 		LOG_L(L_DEBUG, "removing all archives");
 		spring::SafeDelete(vfsHandler);
 		vfsHandler = new CVFSHandler();
+		addedArchives.clear();
 	}
 	UNITSYNC_CATCH_BLOCKS;
 }
@@ -597,6 +780,79 @@ struct InternalMapInfo
 	std::vector<float> zPos;  ///< Start positions Z coordinates defined by the map
 };
 
+/**
+ * @brief checksum used to key mapCache items of a map, 0 if they should not be cached
+ */
+static unsigned int GetMapCacheChecksum(const std::string& mapName)
+{
+	if (!mapCache.IsEnabled())
+		return 0;
+
+	return archiveScanner->GetArchiveCompleteChecksum(mapName);
+}
+
+
+static void WriteCachedMapInfo(unsigned int checksum, const std::string& mapName, const InternalMapInfo* info)
+{
+	std::vector<std::uint8_t> buf;
+
+	PushCacheString(buf, info->description);
+	PushCacheString(buf, info->author);
+	PushCacheValue(buf, info->tidalStrength);
+	PushCacheValue(buf, info->gravity);
+	PushCacheValue(buf, info->maxMetal);
+	PushCacheValue(buf, info->extractorRadius);
+	PushCacheValue(buf, info->minWind);
+	PushCacheValue(buf, info->maxWind);
+	PushCacheValue(buf, info->width);
+	PushCacheValue(buf, info->height);
+	PushCacheValue<std::uint32_t>(buf, info->xPos.size());
+
+	for (size_t i = 0; i < info->xPos.size(); i++) {
+		PushCacheValue(buf, info->xPos[i]);
+		PushCacheValue(buf, info->zPos[i]);
+	}
+
+	mapCache.Write(checksum, mapName, "mapinfo", buf);
+}
+
+static bool ReadCachedMapInfo(unsigned int checksum, const std::string& mapName, InternalMapInfo* info)
+{
+	std::vector<std::uint8_t> buf;
+
+	if (!mapCache.Read(checksum, mapName, "mapinfo", buf))
+		return false;
+
+	CacheReader reader(buf);
+
+	info->description     = reader.PopString();
+	info->author          = reader.PopString();
+	info->tidalStrength   = reader.Pop<int>();
+	info->gravity         = reader.Pop<int>();
+	info->maxMetal        = reader.Pop<float>();
+	info->extractorRadius = reader.Pop<int>();
+	info->minWind         = reader.Pop<int>();
+	info->maxWind         = reader.Pop<int>();
+	info->width           = reader.Pop<int>();
+	info->height          = reader.Pop<int>();
+
+	const std::uint32_t numStartPos = reader.Pop<std::uint32_t>();
+
+	if (!reader.valid || numStartPos > (reader.Remaining() / (sizeof(float) * 2)))
+		return false;
+
+	info->xPos.resize(numStartPos);
+	info->zPos.resize(info->xPos.size());
+
+	for (size_t i = 0; i < info->xPos.size() && reader.valid; i++) {
+		info->xPos[i] = reader.Pop<float>();
+		info->zPos[i] = reader.Pop<float>();
+	}
+
+	return reader.valid;
+}
+
+
 static bool internal_GetMapInfo(const char* mapName, InternalMapInfo* outInfo)
 {
 	CheckInit();
@@ -605,6 +861,13 @@ static bool internal_GetMapInfo(const char* mapName, InternalMapInfo* outInfo)
 
 	LOG_L(L_DEBUG, "get map info: %s", mapName);
 
+	const unsigned int checksum = GetMapCacheChecksum(mapName);
+
+	if (checksum != 0 && ReadCachedMapInfo(checksum, mapName, outInfo))
+		return true;
+
+	*outInfo = {};
+
 	const std::string mapFile = GetMapFile(mapName);
 
 	ScopedMapLoader mapLoader(mapName, mapFile);
@@ -678,6 +941,10 @@ static bool internal_GetMapInfo(const char* mapName, InternalMapInfo* outInfo)
 		LOG_L(L_DEBUG, "startpos: %.0f, %.0f", pos.x, pos.z);
 	}
 
+	// failures are not cached, the map might be fixed by a dependency update
+	if (checksum != 0)
+		WriteCachedMapInfo(checksum, mapName, outInfo);
+
 	return true;
 }
 
@@ -765,47 +1032,71 @@ static void internal_deleteMapInfos() {
 }
 
 
-EXPORT(float) GetMapMinHeight(const char* mapName) {
-	try {
-		CheckInit();
-		const std::string mapFile = GetMapFile(mapName);
-		ScopedMapLoader loader(mapName, mapFile);
-		CSMFMapFile file(mapFile);
-		MapParser parser(mapFile);
+/**
+ * @brief minimum and maximum height of a map, taking mapinfo overrides into account
+ */
+static void internal_GetMapHeightBounds(const char* mapName, float* minHeight, float* maxHeight)
+{
+	CheckInit();
 
-		const SMFHeader& header = file.GetHeader();
-		const LuaTable rootTable = parser.GetRoot();
-		const LuaTable smfTable = rootTable.SubTable("smf");
+	const unsigned int checksum = GetMapCacheChecksum(mapName);
 
-		if (smfTable.KeyExists("minHeight")) {
-			// override the header's minHeight value
-			return (smfTable.GetFloat("minHeight", 0.0f));
-		} else {
-			return (header.minHeight);
+	if (checksum != 0) {
+		std::vector<std::uint8_t> buf;
+
+		if (mapCache.Read(checksum, mapName, "heights", buf)) {
+			CacheReader reader(buf);
+
+			*minHeight = reader.Pop<float>();
+			*maxHeight = reader.Pop<float>();
+
+			if (reader.valid)
+				return;
 		}
 	}
+
+	const std::string mapFile = GetMapFile(mapName);
+	ScopedMapLoader loader(mapName, mapFile);
+	CSMFMapFile file(mapFile);
+	MapParser parser(mapFile);
+
+	const SMFHeader& header = file.GetHeader();
+	const LuaTable rootTable = parser.GetRoot();
+	const LuaTable smfTable = rootTable.SubTable("smf");
+
+	// the mapinfo values override the header's
+	*minHeight = smfTable.KeyExists("minHeight")? smfTable.GetFloat("minHeight", 0.0f): header.minHeight;
+	*maxHeight = smfTable.KeyExists("maxHeight")? smfTable.GetFloat("maxHeight", 0.0f): header.maxHeight;
+
+	if (checksum != 0) {
+		std::vector<std::uint8_t> buf;
+
+		PushCacheValue(buf, *minHeight);
+		PushCacheValue(buf, *maxHeight);
+
+		mapCache.Write(checksum, mapName, "heights", buf);
+	}
+}
+
+EXPORT(float) GetMapMinHeight(const char* mapName) {
+	try {
+		float minHeight = 0.0f;
+		float maxHeight = 0.0f;
+
+		internal_GetMapHeightBounds(mapName, &minHeight, &maxHeight);
+		return minHeight;
+	}
 	UNITSYNC_CATCH_BLOCKS;
 	return 0.0f;
 }
 
 EXPORT(float) GetMapMaxHeight(const char* mapName) {
 	try {
-		CheckInit();
-		const std::string mapFile = GetMapFile(mapName);
-		ScopedMapLoader loader(mapName, mapFile);
-		CSMFMapFile file(mapFile);
-		MapParser parser(mapFile);
-
-		const SMFHeader& header = file.GetHeader();
-		const LuaTable rootTable = parser.GetRoot();
-		const LuaTable smfTable = rootTable.SubTable("smf");
+		float minHeight = 0.0f;
+		float maxHeight = 0.0f;
 
-		if (smfTable.KeyExists("maxHeight")) {
-			// override the header's maxHeight value
-			return (smfTable.GetFloat("maxHeight", 0.0f));
-		} else {
-			return (header.maxHeight);
-		}
+		internal_GetMapHeightBounds(mapName, &minHeight, &maxHeight);
+		return maxHeight;
 	}
 	UNITSYNC_CATCH_BLOCKS;
 	return 0.0f;
@@ -992,6 +1283,21 @@ EXPORT(unsigned short*) GetMinimap(const char* mapName, int mipLevel)
 		if (mipLevel < 0 || mipLevel > 8)
 			throw std::out_of_range("Miplevel must be between 0 and 8 (inclusive) in GetMinimap.");
 
+		const int mipSize = 1024 >> mipLevel;
+		const size_t mipBytes = mipSize * mipSize * sizeof(unsigned short);
+
+		const std::string cacheItem = "minimap" + IntToString(mipLevel);
+		const unsigned int checksum = GetMapCacheChecksum(mapName);
+
+		if (checksum != 0) {
+			std::vector<std::uint8_t> buf;
+
+			if (mapCache.Read(checksum, mapName, cacheItem, buf) && buf.size() == mipBytes) {
+				std::memcpy(imgbuf, buf.data(), mipBytes);
+				return imgbuf;
+			}
+		}
+
 		const std::string mapFile = GetMapFile(mapName);
 		ScopedMapLoader mapLoader(mapName, mapFile);
 
@@ -1003,6 +1309,9 @@ EXPORT(unsigned short*) GetMinimap(const char* mapName, int mipLevel)
 			ret = GetMinimapSM3(mapFile, mipLevel);
 		}
 
+		if (ret != NULL && checksum != 0)
+			mapCache.Write(checksum, mapName, cacheItem, ret, mipBytes);
+
 		return ret;
 	}
 	UNITSYNC_CATCH_BLOCKS;
@@ -1010,6 +1319,92 @@ EXPORT(unsigned short*) GetMinimap(const char* mapName, int mipLevel)
 }
 
 
+/**
+ * @brief info-map in its native format (16 bits per pixel for "height", 8 otherwise)
+ */
+struct InternalInfoMap
+{
+	int width;
+	int height;
+	bool valid; ///< whether the map actually contains this info-map
+	std::vector<std::uint8_t> data;
+};
+
+/**
+ * @brief checksum used to key the cached info-map, 0 if it should not be cached
+ */
+static unsigned int GetInfoMapCacheChecksum(const char* mapName, const std::string& name)
+{
+	// do not let arbitrary names end up in cache file-names
+	if (name != "height" && name != "grass" && name != "metal" && name != "type")
+		return 0;
+
+	return GetMapCacheChecksum(mapName);
+}
+
+static size_t GetInfoMapBytes(const std::string& name, int width, int height)
+{
+	return (size_t(width) * size_t(height) * ((name == "height")? sizeof(unsigned short): sizeof(unsigned char)));
+}
+
+static bool ReadCachedInfoMap(unsigned int checksum, const std::string& mapName, const std::string& name, InternalInfoMap* outMap)
+{
+	std::vector<std::uint8_t> buf;
+
+	if (!mapCache.Read(checksum, mapName, "infomap." + name, buf))
+		return false;
+
+	CacheReader reader(buf);
+
+	outMap->width  = reader.Pop<int>();
+	outMap->height = reader.Pop<int>();
+	outMap->valid  = reader.Pop<std::uint8_t>();
+
+	if (!reader.valid || outMap->width < 0 || outMap->height < 0)
+		return false;
+
+	// callers copy width * height pixels out of data, never trust the item for that
+	if (reader.Remaining() != GetInfoMapBytes(name, outMap->width, outMap->height))
+		return false;
+
+	outMap->data.assign(buf.begin() + reader.pos, buf.end());
+	return true;
+}
+
+static void internal_GetInfoMap(const char* mapName, const std::string& name, InternalInfoMap* outMap)
+{
+	const unsigned int checksum = GetInfoMapCacheChecksum(mapName, name);
+
+	if (checksum != 0 && ReadCachedInfoMap(checksum, mapName, name, outMap))
+		return;
+
+	const std::string mapFile = GetMapFile(mapName);
+	ScopedMapLoader mapLoader(mapName, mapFile);
+	CSMFMapFile file(mapFile);
+	MapBitmapInfo bmInfo;
+
+	file.GetInfoMapSize(name, &bmInfo);
+
+	outMap->width  = bmInfo.width;
+	outMap->height = bmInfo.height;
+	outMap->data.clear();
+	outMap->data.resize(GetInfoMapBytes(name, bmInfo.width, bmInfo.height));
+	outMap->valid = file.ReadInfoMap(name, outMap->data.data());
+
+	if (checksum == 0)
+		return;
+
+	std::vector<std::uint8_t> buf;
+
+	PushCacheValue(buf, outMap->width);
+	PushCacheValue(buf, outMap->height);
+	PushCacheValue<std::uint8_t>(buf, outMap->valid);
+	buf.insert(buf.end(), outMap->data.begin(), outMap->data.end());
+
+	mapCache.Write(checksum, mapName, "infomap." + name, buf);
+}
+
+
 EXPORT(int) GetInfoMapSize(const char* mapName, const char* name, int* width, int* height)
 {
 	try {
@@ -1019,6 +1414,18 @@ EXPORT(int) GetInfoMapSize(const char* mapName, const char* name, int* width, in
 		CheckNull(width);
 		CheckNull(height);
 
+		const unsigned int checksum = GetInfoMapCacheChecksum(mapName, name);
+
+		InternalInfoMap infoMap;
+
+		if (checksum != 0 && ReadCachedInfoMap(checksum, mapName, name, &infoMap)) {
+			*width = infoMap.width;
+			*height = infoMap.height;
+
+			return infoMap.width * infoMap.height;
+		}
+
+		// not cached yet; the size is in the header, do not decode the map for it
 		const std::string mapFile = GetMapFile(mapName);
 		ScopedMapLoader mapLoader(mapName, mapFile);
 		CSMFMapFile file(mapFile);
@@ -1050,33 +1457,31 @@ EXPORT(int) GetInfoMap(const char* mapName, const char* name, unsigned char* dat
 		CheckNullOrEmpty(name);
 		CheckNull(data);
 
-		const std::string mapFile = GetMapFile(mapName);
-		ScopedMapLoader mapLoader(mapName, mapFile);
-		CSMFMapFile file(mapFile);
-
 		const std::string n = name;
 		int actualType = (n == "height" ? bm_grayscale_16 : bm_grayscale_8);
 
 		if (actualType == typeHint) {
-			ret = file.ReadInfoMap(n, data);
+			InternalInfoMap infoMap;
+			internal_GetInfoMap(mapName, n, &infoMap);
+
+			if (infoMap.valid)
+				std::memcpy(data, infoMap.data.data(), infoMap.data.size());
+
+			ret = infoMap.valid;
 		} else if (actualType == bm_grayscale_16 && typeHint == bm_grayscale_8) {
 			// convert from 16 bits per pixel to 8 bits per pixel
-			MapBitmapInfo bmInfo;
-			file.GetInfoMapSize(name, &bmInfo);
-
-			const int size = bmInfo.width * bmInfo.height;
-			if (size > 0) {
-				unsigned short* temp = new unsigned short[size];
-				if (file.ReadInfoMap(n, temp)) {
-					const unsigned short* inp = temp;
-					const unsigned short* inp_end = temp + size;
-					unsigned char* outp = data;
-					for (; inp < inp_end; ++inp, ++outp) {
-						*outp = *inp >> 8;
-					}
-					ret = 1;
+			InternalInfoMap infoMap;
+			internal_GetInfoMap(mapName, n, &infoMap);
+
+			const int size = infoMap.width * infoMap.height;
+			if (size > 0 && infoMap.valid) {
+				const unsigned short* inp = reinterpret_cast<const unsigned short*>(infoMap.data.data());
+				const unsigned short* inp_end = inp + size;
+				unsigned char* outp = data;
+				for (; inp < inp_end; ++inp, ++outp) {
+					*outp = *inp >> 8;
 				}
-				delete[] temp;
+				ret = 1;
 			}
 		} else if (actualType == bm_grayscale_8 && typeHint == bm_grayscale_16) {
 			throw content_error("converting from 8 bits per pixel to 16 bits per pixel is unsupported");